@@ -0,0 +1,848 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/*
+ * This is the rotor benchmark suite: it reproduces the throughput numbers
+ * from README (local and cross-thread ping-pong) and measures other hot
+ * paths (pub/sub fan-out, request/response, actor spawning, timers churn,
+ * supervisors tree shutdown). The results are emitted as JSON, so they can
+ * be compared between releases.
+ *
+ * Usage: rotor_bench [--filter=substring] [--scale=factor] [--out=file] [--list]
+ *
+ */
+
+#include "rotor.hpp"
+#include "rotor/thread.hpp"
+
+#if defined(ROTOR_BENCH_ASIO)
+#include "rotor/asio.hpp"
+#include <boost/asio.hpp>
+#endif
+
+#if defined(ROTOR_BENCH_EV)
+#include "rotor/ev.hpp"
+#include <ev.h>
+#endif
+
+#if defined(ROTOR_BENCH_EPOLL)
+#include "rotor/epoll.hpp"
+#endif
+
+#if defined(ROTOR_BENCH_URING)
+#include "rotor/uring.hpp"
+#endif
+
+#if defined(ROTOR_BENCH_THREAD_POOL)
+#include "rotor/thread_pool.hpp"
+#endif
+
+#if defined(ROTOR_BENCH_CORO)
+#include "rotor/coro.hpp"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace r = rotor;
+namespace rth = rotor::thread;
+
+using bench_clock_t = std::chrono::steady_clock;
+
+static const auto actor_timeout = r::pt::milliseconds{500};
+static const auto request_timeout = r::pt::seconds{10};
+
+/* the ping and pong threads might share a CPU, then spinning on the inbound queue before
+ * parking just steals the time of the peer; so, the backends are compared by their wake-up path */
+static const auto cross_thread_poll = r::pt::time_duration{};
+
+struct measurement_t {
+    std::size_t items = 0;
+    bench_clock_t::time_point start;
+    bench_clock_t::time_point finish;
+
+    double seconds() const noexcept { return std::chrono::duration<double>(finish - start).count(); }
+};
+
+/* counts down events, and records the finish time when the last one arrives */
+struct countdown_t {
+    measurement_t &measurement;
+    std::size_t remaining;
+
+    bool tick() noexcept {
+        if (--remaining) {
+            return false;
+        }
+        measurement.finish = bench_clock_t::now();
+        return true;
+    }
+};
+
+namespace payload {
+struct ping_t {};
+struct pong_t {};
+struct sample_t {
+    std::uint64_t value;
+};
+struct echo_res_t {
+    std::uint64_t value;
+};
+struct echo_req_t {
+    using response_t = echo_res_t;
+    std::uint64_t value;
+};
+} // namespace payload
+
+namespace message {
+using ping_t = r::message_t<payload::ping_t>;
+using pong_t = r::message_t<payload::pong_t>;
+using sample_t = r::message_t<payload::sample_t>;
+using echo_req_t = r::request_traits_t<payload::echo_req_t>::request::message_t;
+using echo_res_t = r::request_traits_t<payload::echo_req_t>::response::message_t;
+} // namespace message
+
+/* ping-pong */
+
+struct ponger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&ponger_t::on_ping); });
+    }
+
+    void on_ping(message::ping_t &) noexcept { send<payload::pong_t>(pinger_addr); }
+
+    r::address_ptr_t pinger_addr;
+};
+
+struct pinger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&pinger_t::on_pong); });
+        plugin.with_casted<r::plugin::link_client_plugin_t>([&](auto &p) { p.link(ponger_addr, true); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        measurement->start = bench_clock_t::now();
+        send<payload::ping_t>(ponger_addr);
+    }
+
+    void on_pong(message::pong_t &) noexcept {
+        if (countdown->tick()) {
+            do_shutdown();
+        } else {
+            send<payload::ping_t>(ponger_addr);
+        }
+    }
+
+    r::address_ptr_t ponger_addr;
+    measurement_t *measurement;
+    countdown_t *countdown;
+};
+
+static measurement_t bench_ping_pong_local(std::size_t count) {
+    measurement_t m;
+    countdown_t countdown{m, count};
+    rth::system_context_thread_t ctx;
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+    auto pinger = sup->create_actor<pinger_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup->create_actor<ponger_t>().timeout(actor_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->measurement = &m;
+    pinger->countdown = &countdown;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup->start();
+    ctx.run();
+    m.items = count * 2;
+    return m;
+}
+
+#if !defined(ROTOR_REFCOUNT_THREADUNSAFE)
+static measurement_t bench_ping_pong_thread(std::size_t count) {
+    measurement_t m;
+    countdown_t countdown{m, count};
+    rth::system_context_thread_t ctx_ping;
+    rth::system_context_thread_t ctx_pong;
+    auto sup_ping = ctx_ping.create_supervisor<rth::supervisor_thread_t>()
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .finish();
+    auto sup_pong = ctx_pong.create_supervisor<rth::supervisor_thread_t>()
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .finish();
+    auto pinger = sup_ping->create_actor<pinger_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup_pong->create_actor<ponger_t>().timeout(actor_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->measurement = &m;
+    pinger->countdown = &countdown;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup_ping->start();
+    sup_pong->start();
+    auto pong_thread = std::thread([&] { ctx_pong.run(); });
+    ctx_ping.run();
+    sup_pong->shutdown();
+    pong_thread.join();
+    m.items = count * 2;
+    return m;
+}
+
+#if defined(ROTOR_BENCH_ASIO)
+static measurement_t bench_ping_pong_asio(std::size_t count) {
+    namespace asio = boost::asio;
+    namespace ra = rotor::asio;
+
+    measurement_t m;
+    countdown_t countdown{m, count};
+    asio::io_context io_ping;
+    asio::io_context io_pong;
+    auto ctx_ping = ra::system_context_asio_t::ptr_t{new ra::system_context_asio_t(io_ping)};
+    auto ctx_pong = ra::system_context_asio_t::ptr_t{new ra::system_context_asio_t(io_pong)};
+    auto strand_ping = std::make_shared<asio::io_context::strand>(io_ping);
+    auto strand_pong = std::make_shared<asio::io_context::strand>(io_pong);
+    auto sup_ping = ctx_ping->create_supervisor<ra::supervisor_asio_t>()
+                        .strand(strand_ping)
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .guard_context(true)
+                        .finish();
+    auto sup_pong = ctx_pong->create_supervisor<ra::supervisor_asio_t>()
+                        .strand(strand_pong)
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .guard_context(true)
+                        .finish();
+    auto pinger = sup_ping->create_actor<pinger_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup_pong->create_actor<ponger_t>().timeout(actor_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->measurement = &m;
+    pinger->countdown = &countdown;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup_ping->start();
+    sup_pong->start();
+    auto pong_thread = std::thread([&] { io_pong.run(); });
+    io_ping.run();
+    sup_pong->shutdown();
+    pong_thread.join();
+    m.items = count * 2;
+    return m;
+}
+#endif
+
+#if defined(ROTOR_BENCH_EV)
+static measurement_t bench_ping_pong_ev(std::size_t count) {
+    namespace rev = rotor::ev;
+
+    measurement_t m;
+    countdown_t countdown{m, count};
+    auto loop_ping = ev_loop_new(0);
+    auto loop_pong = ev_loop_new(0);
+    auto ctx_ping = rev::system_context_ev_t();
+    auto ctx_pong = rev::system_context_ev_t();
+    auto sup_ping = ctx_ping.create_supervisor<rev::supervisor_ev_t>()
+                        .loop(loop_ping)
+                        .loop_ownership(true)
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .finish();
+    auto sup_pong = ctx_pong.create_supervisor<rev::supervisor_ev_t>()
+                        .loop(loop_pong)
+                        .loop_ownership(true)
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .finish();
+    auto pinger = sup_ping->create_actor<pinger_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup_pong->create_actor<ponger_t>().timeout(actor_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->measurement = &m;
+    pinger->countdown = &countdown;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup_ping->start();
+    sup_pong->start();
+    auto pong_thread = std::thread([&] { ev_run(loop_pong); });
+    ev_run(loop_ping);
+    sup_pong->shutdown();
+    pong_thread.join();
+    m.items = count * 2;
+    return m;
+}
+#endif
+
+#if defined(ROTOR_BENCH_EPOLL)
+static measurement_t bench_ping_pong_epoll(std::size_t count) {
+    namespace rep = rotor::epoll;
+
+    measurement_t m;
+    countdown_t countdown{m, count};
+    auto ctx_ping = rep::system_context_ptr_t(new rep::system_context_epoll_t());
+    auto ctx_pong = rep::system_context_ptr_t(new rep::system_context_epoll_t());
+    auto sup_ping = ctx_ping->create_supervisor<rep::supervisor_epoll_t>()
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .finish();
+    auto sup_pong = ctx_pong->create_supervisor<rep::supervisor_epoll_t>()
+                        .timeout(actor_timeout)
+                        .poll_duration(cross_thread_poll)
+                        .finish();
+    auto pinger = sup_ping->create_actor<pinger_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup_pong->create_actor<ponger_t>().timeout(actor_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->measurement = &m;
+    pinger->countdown = &countdown;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup_ping->start();
+    sup_pong->start();
+    auto pong_thread = std::thread([&] { ctx_pong->run(); });
+    ctx_ping->run();
+    sup_pong->shutdown();
+    pong_thread.join();
+    m.items = count * 2;
+    return m;
+}
+#endif
+
+#if defined(ROTOR_BENCH_URING)
+static measurement_t bench_ping_pong_uring(std::size_t count) {
+    namespace ru = rotor::uring;
+
+    measurement_t m;
+    countdown_t countdown{m, count};
+    auto ctx_ping = ru::system_context_ptr_t(new ru::system_context_uring_t());
+    auto ctx_pong = ru::system_context_ptr_t(new ru::system_context_uring_t());
+    auto &ec = ctx_ping->get_error() ? ctx_ping->get_error() : ctx_pong->get_error();
+    if (ec) {
+        std::cerr << "io_uring is not available: " << ec.message() << ", ";
+        return m;
+    }
+    auto sup_ping = ctx_ping->create_supervisor<ru::supervisor_uring_t>().timeout(actor_timeout).finish();
+    auto sup_pong = ctx_pong->create_supervisor<ru::supervisor_uring_t>().timeout(actor_timeout).finish();
+    auto pinger = sup_ping->create_actor<pinger_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup_pong->create_actor<ponger_t>().timeout(actor_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->measurement = &m;
+    pinger->countdown = &countdown;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup_ping->start();
+    sup_pong->start();
+    auto pong_thread = std::thread([&] { ctx_pong->run(); });
+    ctx_ping->run();
+    sup_pong->shutdown();
+    pong_thread.join();
+    m.items = count * 2;
+    return m;
+}
+#endif
+
+#if defined(ROTOR_BENCH_THREAD_POOL)
+static measurement_t bench_ping_pong_thread_pool(std::size_t count) {
+    namespace rtp = rotor::thread_pool;
+
+    measurement_t m;
+    countdown_t countdown{m, count};
+    auto ctx = rtp::system_context_ptr_t(new rtp::system_context_thread_pool_t(2));
+    auto sup_ping = ctx->create_supervisor<rtp::supervisor_thread_pool_t>().timeout(actor_timeout).finish();
+    // the child supervisor is a locality (scheduling unit) of its own
+    auto sup_pong = sup_ping->create_actor<rtp::supervisor_thread_pool_t>().timeout(actor_timeout).finish();
+    auto pinger = sup_ping->create_actor<pinger_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    auto ponger = sup_pong->create_actor<ponger_t>().timeout(actor_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->measurement = &m;
+    pinger->countdown = &countdown;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup_ping->start();
+    ctx->run();
+    m.items = count * 2;
+    return m;
+}
+#endif
+#endif
+
+/* pub/sub fan-out */
+
+struct publisher_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        measurement->start = bench_clock_t::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            send<payload::sample_t>(topic, i);
+        }
+    }
+
+    r::address_ptr_t topic;
+    measurement_t *measurement;
+    std::size_t count;
+};
+
+struct subscriber_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>(
+            [&](auto &p) { p.subscribe_actor(&subscriber_t::on_sample, topic); });
+    }
+
+    void on_sample(message::sample_t &) noexcept {
+        if (countdown->tick()) {
+            supervisor->do_shutdown();
+        }
+    }
+
+    r::address_ptr_t topic;
+    countdown_t *countdown;
+};
+
+static measurement_t bench_fan_out(std::size_t count) {
+    static constexpr std::size_t subscribers = 16;
+    auto messages = std::max(std::size_t{1}, count / subscribers);
+
+    measurement_t m;
+    countdown_t countdown{m, messages * subscribers};
+    rth::system_context_thread_t ctx;
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+    auto topic = sup->create_address();
+    for (std::size_t i = 0; i < subscribers; ++i) {
+        auto sub = sup->create_actor<subscriber_t>().timeout(actor_timeout).finish();
+        sub->topic = topic;
+        sub->countdown = &countdown;
+    }
+    auto pub = sup->create_actor<publisher_t>().timeout(actor_timeout).finish();
+    pub->topic = topic;
+    pub->measurement = &m;
+    pub->count = messages;
+
+    sup->start();
+    ctx.run();
+    m.items = messages * subscribers;
+    return m;
+}
+
+/* request/response */
+
+struct server_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&server_t::on_request); });
+    }
+
+    void on_request(message::echo_req_t &req) noexcept { reply_to(req, req.payload.request_payload.value); }
+};
+
+struct client_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&client_t::on_response); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        measurement->start = bench_clock_t::now();
+        request<payload::echo_req_t>(server_addr, std::uint64_t{0}).send(request_timeout);
+    }
+
+    void on_response(message::echo_res_t &res) noexcept {
+        if (res.payload.ee || countdown->tick()) {
+            do_shutdown();
+        } else {
+            request<payload::echo_req_t>(server_addr, res.payload.res.value + 1).send(request_timeout);
+        }
+    }
+
+    r::address_ptr_t server_addr;
+    measurement_t *measurement;
+    countdown_t *countdown;
+};
+
+static measurement_t run_request_response(std::size_t count, const r::pt::time_duration &request_tick) {
+    measurement_t m;
+    countdown_t countdown{m, count};
+    rth::system_context_thread_t ctx;
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>()
+                   .timeout(actor_timeout)
+                   .request_tick(request_tick)
+                   .finish();
+    auto server = sup->create_actor<server_t>().timeout(actor_timeout).finish();
+    auto client = sup->create_actor<client_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    client->server_addr = server->get_address();
+    client->measurement = &m;
+    client->countdown = &countdown;
+
+    sup->start();
+    ctx.run();
+    m.items = count;
+    return m;
+}
+
+static measurement_t bench_request_response(std::size_t count) {
+    return run_request_response(count, r::pt::time_duration{});
+}
+
+static measurement_t bench_request_response_wheel(std::size_t count) {
+    return run_request_response(count, r::pt::millisec{10});
+}
+
+#if defined(ROTOR_BENCH_CORO)
+struct coro_client_t : public r::coro::actor_t {
+    using r::coro::actor_t::actor_t;
+
+    void on_start() noexcept override {
+        r::coro::actor_t::on_start();
+        measurement->start = bench_clock_t::now();
+        flow();
+    }
+
+    r::coro::task_t flow() noexcept {
+        std::uint64_t value = 0;
+        while (true) {
+            auto res = co_await request<payload::echo_req_t>(server_addr, value).send(request_timeout);
+            if (res->payload.ee || countdown->tick()) {
+                break;
+            }
+            value = res->payload.res.value + 1;
+        }
+        do_shutdown();
+    }
+
+    r::address_ptr_t server_addr;
+    measurement_t *measurement;
+    countdown_t *countdown;
+};
+
+static measurement_t bench_request_response_coro(std::size_t count) {
+    measurement_t m;
+    countdown_t countdown{m, count};
+    rth::system_context_thread_t ctx;
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+    auto server = sup->create_actor<server_t>().timeout(actor_timeout).finish();
+    auto client = sup->create_actor<coro_client_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    client->server_addr = server->get_address();
+    client->measurement = &m;
+    client->countdown = &countdown;
+
+    sup->start();
+    ctx.run();
+    m.items = count;
+    return m;
+}
+#endif
+
+/* actors spawn */
+
+struct spawnee_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        if (countdown->tick()) {
+            supervisor->do_shutdown();
+        }
+    }
+
+    countdown_t *countdown;
+};
+
+struct spawner_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        auto count = countdown->remaining;
+        countdown->measurement.start = bench_clock_t::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto actor = supervisor->create_actor<spawnee_t>().timeout(actor_timeout).finish();
+            actor->countdown = countdown;
+        }
+    }
+
+    countdown_t *countdown;
+};
+
+static measurement_t bench_spawn(std::size_t count) {
+    measurement_t m;
+    countdown_t countdown{m, count};
+    rth::system_context_thread_t ctx;
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+    auto spawner = sup->create_actor<spawner_t>().timeout(actor_timeout).finish();
+    spawner->countdown = &countdown;
+
+    sup->start();
+    ctx.run();
+    m.items = count;
+    return m;
+}
+
+/* children scaling: spawn of many children under single supervisor, and its shutdown */
+
+static measurement_t bench_children(std::size_t count) {
+    measurement_t m;
+    measurement_t started;
+    countdown_t countdown{started, count};
+    m.start = bench_clock_t::now();
+    rth::system_context_thread_t ctx;
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+    for (std::size_t i = 0; i < count; ++i) {
+        auto actor = sup->create_actor<spawnee_t>().timeout(actor_timeout).finish();
+        actor->countdown = &countdown;
+    }
+
+    sup->start();
+    ctx.run();
+    m.finish = bench_clock_t::now();
+    m.items = count;
+    return m;
+}
+
+/* timers churn: a window of active timers, each new timer cancels the oldest one */
+
+struct timers_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+    static constexpr std::size_t window = 1024;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        std::vector<r::request_id_t> ids(window);
+        measurement->start = bench_clock_t::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto &slot = ids[i % window];
+            if (i >= window) {
+                cancel_timer(slot);
+            }
+            auto timeout = r::pt::milliseconds{static_cast<long>(1000 + (i * 7919) % 1000)};
+            slot = start_timer(timeout, *this, &timers_actor_t::on_timer);
+        }
+        for (std::size_t i = 0; i < std::min(count, window); ++i) {
+            cancel_timer(ids[i]);
+        }
+        measurement->finish = bench_clock_t::now();
+        do_shutdown();
+    }
+
+    void on_timer(r::request_id_t, bool) noexcept {}
+
+    measurement_t *measurement;
+    std::size_t count;
+};
+
+static measurement_t bench_timers(std::size_t count) {
+    measurement_t m;
+    rth::system_context_thread_t ctx;
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+    auto actor = sup->create_actor<timers_actor_t>().timeout(actor_timeout).autoshutdown_supervisor().finish();
+    actor->measurement = &m;
+    actor->count = count;
+
+    sup->start();
+    ctx.run();
+    m.items = count;
+    return m;
+}
+
+/* supervisors tree shutdown: measured from the moment when all leaves are started */
+
+struct leaf_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        if (!--*remaining) {
+            measurement->start = bench_clock_t::now();
+            root->do_shutdown();
+        }
+    }
+
+    r::supervisor_t *root;
+    measurement_t *measurement;
+    std::size_t *remaining;
+};
+
+static measurement_t bench_tree_shutdown(std::size_t count) {
+    static constexpr std::size_t branches = 32;
+    auto leaves = std::max(std::size_t{1}, count / branches);
+    auto remaining = leaves * branches;
+
+    measurement_t m;
+    rth::system_context_thread_t ctx;
+    auto root = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+    for (std::size_t i = 0; i < branches; ++i) {
+        auto branch = root->create_actor<rth::supervisor_thread_t>().timeout(actor_timeout).finish();
+        for (std::size_t j = 0; j < leaves; ++j) {
+            auto leaf = branch->create_actor<leaf_t>().timeout(actor_timeout).finish();
+            leaf->root = root.get();
+            leaf->measurement = &m;
+            leaf->remaining = &remaining;
+        }
+    }
+
+    root->start();
+    ctx.run();
+    m.finish = bench_clock_t::now();
+    m.items = branches * (leaves + 1) + 1;
+    return m;
+}
+
+/* harness */
+
+struct benchmark_t {
+    const char *name;
+    std::size_t count;
+    std::function<measurement_t(std::size_t)> fn;
+};
+
+struct result_t {
+    const char *name;
+    std::size_t iterations;
+    measurement_t measurement;
+};
+
+static std::vector<benchmark_t> make_benchmarks() {
+    std::vector<benchmark_t> benchmarks;
+    benchmarks.push_back({"ping_pong/local", 1000000, bench_ping_pong_local});
+#if !defined(ROTOR_REFCOUNT_THREADUNSAFE)
+    benchmarks.push_back({"ping_pong/cross_thread/thread", 100000, bench_ping_pong_thread});
+#if defined(ROTOR_BENCH_ASIO)
+    benchmarks.push_back({"ping_pong/cross_thread/asio", 100000, bench_ping_pong_asio});
+#endif
+#if defined(ROTOR_BENCH_EV)
+    benchmarks.push_back({"ping_pong/cross_thread/ev", 100000, bench_ping_pong_ev});
+#endif
+#if defined(ROTOR_BENCH_EPOLL)
+    benchmarks.push_back({"ping_pong/cross_thread/epoll", 100000, bench_ping_pong_epoll});
+#endif
+#if defined(ROTOR_BENCH_URING)
+    benchmarks.push_back({"ping_pong/cross_thread/uring", 100000, bench_ping_pong_uring});
+#endif
+#if defined(ROTOR_BENCH_THREAD_POOL)
+    benchmarks.push_back({"ping_pong/cross_thread/thread_pool", 100000, bench_ping_pong_thread_pool});
+#endif
+#endif
+    benchmarks.push_back({"pub_sub/fan_out", 1000000, bench_fan_out});
+    benchmarks.push_back({"request_response", 200000, bench_request_response});
+    benchmarks.push_back({"request_response/wheel", 200000, bench_request_response_wheel});
+#if defined(ROTOR_BENCH_CORO)
+    benchmarks.push_back({"request_response/coro", 200000, bench_request_response_coro});
+#endif
+    benchmarks.push_back({"actor/spawn", 10000, bench_spawn});
+    benchmarks.push_back({"supervisor/children/10k", 10000, bench_children});
+    benchmarks.push_back({"supervisor/children/100k", 100000, bench_children});
+    benchmarks.push_back({"supervisor/children/1M", 1000000, bench_children});
+    benchmarks.push_back({"timer/churn", 1000000, bench_timers});
+    benchmarks.push_back({"supervisor/tree_shutdown", 10000, bench_tree_shutdown});
+    return benchmarks;
+}
+
+static void write_json(std::ostream &out, const std::vector<result_t> &results, double scale) {
+    char date[32];
+    auto now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out << std::setprecision(9);
+    out << "{\n";
+    out << "  \"context\": {\n";
+    out << "    \"library\": \"rotor\",\n";
+    out << "    \"version\": \"" << ROTOR_BENCH_VERSION << "\",\n";
+    out << "    \"date\": \"" << date << "\",\n";
+    out << "    \"scale\": " << scale << ",\n";
+    out << "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << "\n";
+    out << "  },\n";
+    out << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        auto &res = results[i];
+        auto seconds = res.measurement.seconds();
+        auto rate = seconds > 0 ? res.measurement.items / seconds : 0.0;
+        out << (i ? "," : "") << "\n    {\n";
+        out << "      \"name\": \"" << res.name << "\",\n";
+        out << "      \"iterations\": " << res.iterations << ",\n";
+        out << "      \"items\": " << res.measurement.items << ",\n";
+        out << "      \"real_time_s\": " << seconds << ",\n";
+        out << "      \"items_per_second\": " << rate << "\n";
+        out << "    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int main(int argc, char **argv) {
+    std::string filter;
+    std::string out_file;
+    double scale = 1.0;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        auto arg = std::string(argv[i]);
+        if (arg.rfind("--filter=", 0) == 0) {
+            filter = arg.substr(std::strlen("--filter="));
+        } else if (arg.rfind("--scale=", 0) == 0) {
+            scale = std::atof(arg.c_str() + std::strlen("--scale="));
+        } else if (arg.rfind("--out=", 0) == 0) {
+            out_file = arg.substr(std::strlen("--out="));
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            std::cerr << "usage: " << argv[0] << " [--filter=substring] [--scale=factor] [--out=file] [--list]\n";
+            return 1;
+        }
+    }
+    if (scale <= 0) {
+        std::cerr << "scale should be positive\n";
+        return 1;
+    }
+
+    std::vector<result_t> results;
+    for (auto &b : make_benchmarks()) {
+        if (!filter.empty() && std::string(b.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        if (list) {
+            std::cout << b.name << "\n";
+            continue;
+        }
+        auto iterations = std::max(std::size_t{1}, static_cast<std::size_t>(b.count * scale));
+        std::cerr << "running " << b.name << " (" << iterations << ")... " << std::flush;
+        auto m = b.fn(iterations);
+        std::cerr << static_cast<std::size_t>(m.items / std::max(m.seconds(), 1e-9)) << " items/s\n";
+        results.push_back({b.name, iterations, m});
+    }
+    if (list) {
+        return 0;
+    }
+
+    if (out_file.empty()) {
+        write_json(std::cout, results, scale);
+    } else {
+        std::ofstream out(out_file);
+        if (!out) {
+            std::cerr << "cannot open " << out_file << "\n";
+            return 1;
+        }
+        write_json(out, results, scale);
+    }
+    return 0;
+}
@@ -28,6 +28,7 @@ class RotorConan(ConanFile):
         "enable_ev" : [True, False],
         "enable_thread": [True, False],
         "multithreading": [True, False],  # enables multithreading support
+        "hybrid_refcount": [True, False],  # non-atomic refcounting for locality-local messages
     }
     default_options = {
         "fPIC": True,
@@ -36,6 +37,7 @@ class RotorConan(ConanFile):
         "enable_ev" : False,
         "enable_thread": True,
         "multithreading": True,
+        "hybrid_refcount": False,
     }
 
     def config_options(self):
@@ -64,6 +66,7 @@ class RotorConan(ConanFile):
         tc.variables["BUILD_EV"] = self.options.enable_ev
         tc.variables["BUILD_EXAMPLES"] = os.environ.get('ROTOR_BUILD_EXAMPLES', 'OFF')
         tc.variables["BUILD_THREAD_UNSAFE"] = not self.options.multithreading
+        tc.variables["BUILD_HYBRID_REFCOUNT"] = self.options.hybrid_refcount
         tc.variables["BUILD_TESTING"] = not self.conf.get("tools.build:skip_test", default=True, check_type=bool)
         tc.generate()
         tc = CMakeDeps(self)
@@ -114,6 +117,8 @@ class RotorConan(ConanFile):
 
         if not self.options.multithreading:
             self.cpp_info.components["core"].defines.append("BUILD_THREAD_UNSAFE")
+        elif self.options.hybrid_refcount:
+            self.cpp_info.components["core"].defines.append("ROTOR_REFCOUNT_HYBRID")
 
         if self.options.enable_asio:
             self.cpp_info.components["asio"].libs = ["rotor_asio"]
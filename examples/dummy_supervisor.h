@@ -26,7 +26,8 @@ struct dummy_supervisor_t : public rotor::supervisor_t {
         timers_map.emplace(handler.request_id, &handler);
     }
 
-    void do_cancel_timer(rotor::request_id_t timer_id) noexcept override {
+    void do_cancel_timer(rotor::timer_handler_base_t &handler) noexcept override {
+        auto timer_id = handler.request_id;
         auto it = timers_map.find(timer_id);
         auto &actor_ptr = it->second->owner;
         actor_ptr->access<to::on_timer_trigger, rotor::request_id_t, bool>(timer_id, true);
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/*
+ * This is a benchmark of timers of thread backend: a lot of concurrent
+ * timers are started, half of them are cancelled, and the rest are
+ * waited for triggering.
+ *
+ */
+
+#include "rotor.hpp"
+#include "rotor/thread.hpp"
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace r = rotor;
+namespace rth = rotor::thread;
+
+struct timers_actor_t : public r::actor_base_t {
+    using clock_t = std::chrono::high_resolution_clock;
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        ids.reserve(count);
+
+        auto t0 = clock_t::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto timeout = r::pt::milliseconds{static_cast<long>(1 + (i * 7919) % 100)};
+            ids.push_back(start_timer(timeout, *this, &timers_actor_t::on_timer));
+        }
+        auto t1 = clock_t::now();
+        for (std::size_t i = 0; i < count; i += 2) {
+            cancel_timer(ids[i]);
+        }
+        auto t2 = clock_t::now();
+        started = t2;
+
+        std::chrono::duration<double> start_time = t1 - t0;
+        std::chrono::duration<double> cancel_time = t2 - t1;
+        std::cout << std::fixed << std::setprecision(6);
+        std::cout << "started " << count << " timers in " << start_time.count() << "s ("
+                  << static_cast<std::size_t>(count / start_time.count()) << " timers/s)\n";
+        std::cout << "cancelled " << cancelled << " timers in " << cancel_time.count() << "s ("
+                  << static_cast<std::size_t>(cancelled / cancel_time.count()) << " timers/s)\n";
+    }
+
+    void on_timer(r::request_id_t, bool cancel) noexcept {
+        if (cancel) {
+            ++cancelled;
+            return;
+        }
+        if (++triggered + cancelled == count) {
+            std::chrono::duration<double> diff = clock_t::now() - started;
+            std::cout << "triggered " << triggered << " timers in " << diff.count() << "s\n";
+            do_shutdown();
+        }
+    }
+
+    std::size_t count = 0;
+    std::size_t triggered = 0;
+    std::size_t cancelled = 0;
+    std::vector<r::request_id_t> ids;
+    clock_t::time_point started;
+};
+
+int main(int argc, char **argv) {
+    std::size_t count = 100000;
+    if (argc > 1) {
+        boost::conversion::try_lexical_convert(argv[1], count);
+    }
+
+    rth::system_context_thread_t ctx;
+    auto timeout = r::pt::milliseconds{500};
+    auto sup = ctx.create_supervisor<rth::supervisor_thread_t>().timeout(timeout).finish();
+    auto actor = sup->create_actor<timers_actor_t>().timeout(timeout).autoshutdown_supervisor().finish();
+    actor->count = count;
+
+    sup->start();
+    ctx.run();
+
+    std::cout << "exiting...\n";
+    return 0;
+}
@@ -14,6 +14,7 @@
 #include "handler.h"
 #include "extended_error.h"
 #include "timer_handler.hpp"
+#include "detail/request_table.h"
 #include <set>
 
 #if defined(_MSC_VER)
@@ -124,6 +125,22 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
      */
     template <typename M, typename... Args> void send(const address_ptr_t &addr, Args &&...args);
 
+    /** \brief sends message with the specified priority, overriding the priority of the payload type
+     *
+     * See `send` and {@link message_priority_t}.
+     *
+     */
+    template <typename M, typename... Args>
+    void send(message_priority_t priority, const address_ptr_t &addr, Args &&...args);
+
+    /** \brief sends message with the time-to-live, i.e. it is dropped if it is not delivered in time
+     *
+     * See `send` and `message_base_t::deadline`.
+     *
+     */
+    template <typename M, typename... Args>
+    void send(const pt::time_duration &ttl, const address_ptr_t &addr, Args &&...args);
+
     /** \brief returns request builder for destination address using the "main" actor address
      *
      * The `args` are forwarded for construction of the request. The request is not actually sent,
@@ -149,6 +166,32 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     request_builder_t<typename request_wrapper_t<R>::request_t>
     request_via(const address_ptr_t &dest_addr, const address_ptr_t &reply_addr, Args &&...args);
 
+    /** \brief returns builder of the request, which is scattered to all the destination addresses
+     *
+     * The requests are constructed from `args` (one per destination) and share single
+     * timeout. The single `request_traits_t<R>::all_response::message_t` is delivered to
+     * the actor's main address, when all the responses arrived or upon timeout (the unanswered
+     * requests are cancelled via `request_traits_t<R>::cancel::message_t`). The destination
+     * addresses must be distinct.
+     *
+     */
+    template <typename R, typename... Args>
+    gather_builder_t<typename request_wrapper_t<R>::request_t, gather_mode_t::all>
+    request_all(const std::vector<address_ptr_t> &dest_addrs, Args &&...args);
+
+    /** \brief returns builder of the request, which is scattered to all the destination addresses,
+     * where the first successful response wins
+     *
+     * The single `request_traits_t<R>::any_response::message_t` is delivered to the actor's
+     * main address upon the first successful response (the rest requests are cancelled via
+     * `request_traits_t<R>::cancel::message_t`), or when all the responses are errors, or upon timeout
+     * (the unanswered requests are cancelled too). The destination addresses must be distinct.
+     *
+     */
+    template <typename R, typename... Args>
+    gather_builder_t<typename request_wrapper_t<R>::request_t, gather_mode_t::any>
+    request_any(const std::vector<address_ptr_t> &dest_addrs, Args &&...args);
+
     /** \brief convenient method for constructing and sending response to a request
      *
      * `args` are forwarded to response payload construction
@@ -389,7 +432,7 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     using timers_map_t = std::unordered_map<request_id_t, timer_handler_ptr_t>;
 
     /** \brief list of ids of active requests (type) */
-    using requests_t = std::unordered_set<request_id_t>;
+    using requests_t = detail::request_list_t;
 
     /** \brief triggers timer handler associated with the timer id */
     void on_timer_trigger(request_id_t request_id, bool cancelled) noexcept;
@@ -491,6 +534,7 @@ struct ROTOR_API actor_base_t : public arc_base_t<actor_base_t> {
     friend struct plugin::lifetime_plugin_t;
     friend struct supervisor_t;
     template <typename T> friend struct request_builder_t;
+    template <typename T, gather_mode_t Mode> friend struct gather_builder_t;
     template <typename T, typename M> friend struct accessor_t;
 };
 
@@ -11,6 +11,10 @@
 
 namespace rotor {
 
+namespace detail {
+struct dispatch_table_t;
+}
+
 /** \struct address_t
  *  \brief Message subscription and delivery point
  *
@@ -50,7 +54,12 @@ struct address_t : public arc_base_t<address_t> {
 
   private:
     friend struct supervisor_t;
-    address_t(supervisor_t &sup, const void *locality_) : supervisor{sup}, locality{locality_} {}
+    friend struct subscription_t;
+    address_t(supervisor_t &sup, const void *locality_)
+        : supervisor{sup}, locality{locality_}, dispatch_table{nullptr} {}
+
+    /** \brief handlers of the address by message type, maintained by the locality {@link subscription_t} */
+    detail::dispatch_table_t *dispatch_table;
 };
 
 /** \brief intrusive pointer for address */
@@ -64,7 +64,8 @@ struct ROTOR_API address_mapping_t {
     void remove(const subscription_point_t &point) noexcept;
 
   private:
-    using point_map_t = std::unordered_map<const void *, subscription_info_ptr_t>;
+    /* an actor has a few mapped message types, so linear search is faster than hashing */
+    using point_map_t = std::vector<std::pair<const void *, subscription_info_ptr_t>>;
     using actor_map_t = std::unordered_map<const void *, point_map_t>;
     actor_map_t actor_map;
 };
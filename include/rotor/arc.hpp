@@ -10,6 +10,10 @@
 #include <boost/smart_ptr/intrusive_ref_counter.hpp>
 #include "rotor/export.h"
 
+#if defined(ROTOR_REFCOUNT_HYBRID)
+#include <atomic>
+#endif
+
 namespace rotor {
 
 #ifdef ROTOR_REFCOUNT_THREADUNSAFE
@@ -26,4 +30,92 @@ template <typename T> using arc_base_t = boost::intrusive_ref_counter<T, counter
 /** \brief alias for intrusive pointer */
 template <typename T> using intrusive_ptr_t = boost::intrusive_ptr<T>;
 
+#if defined(ROTOR_REFCOUNT_HYBRID)
+
+template <typename T> struct hybrid_arc_base_t;
+template <typename T> void intrusive_ptr_add_ref(const hybrid_arc_base_t<T> *ptr) noexcept;
+template <typename T> void intrusive_ptr_release(const hybrid_arc_base_t<T> *ptr) noexcept;
+
+/** \struct hybrid_arc_base_t
+ *  \brief base class to inject hybrid ref-counter
+ *
+ * The counter is modified non-atomically, while the object is owned by a single
+ * thread (locality). Once it is marked as shared, which must be done by the owner
+ * before the object is handed to another thread, the counter is modified atomically.
+ *
+ */
+template <typename T> struct hybrid_arc_base_t {
+    /** \brief constructs non-shared object with zero ref-counter */
+    hybrid_arc_base_t() noexcept : counter{0}, shared{false} {}
+
+    /** \brief copy constructor, the ref-counter is not copied */
+    hybrid_arc_base_t(const hybrid_arc_base_t &) noexcept : counter{0}, shared{false} {}
+
+    /** \brief assignment, the ref-counter is not copied */
+    hybrid_arc_base_t &operator=(const hybrid_arc_base_t &) noexcept { return *this; }
+
+    /** \brief returns the current ref-counter value */
+    unsigned int use_count() const noexcept { return counter.load(std::memory_order_relaxed); }
+
+    /** \brief returns true if the object counter is modified atomically */
+    bool is_shared() const noexcept { return shared; }
+
+    /** \brief switches to atomic counting; returns `false` if it was already shared */
+    bool set_shared() const noexcept {
+        if (shared) {
+            return false;
+        }
+        shared = true;
+        return true;
+    }
+
+  protected:
+    ~hybrid_arc_base_t() = default;
+
+  private:
+    mutable std::atomic<unsigned int> counter;
+    mutable bool shared;
+
+    friend void intrusive_ptr_add_ref<T>(const hybrid_arc_base_t<T> *ptr) noexcept;
+    friend void intrusive_ptr_release<T>(const hybrid_arc_base_t<T> *ptr) noexcept;
+};
+
+/** \brief increments hybrid ref-counter */
+template <typename T> inline void intrusive_ptr_add_ref(const hybrid_arc_base_t<T> *ptr) noexcept {
+    auto &counter = ptr->counter;
+    if (!ptr->shared) {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    } else {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/** \brief decrements hybrid ref-counter and destroys the object when it reaches zero */
+template <typename T> inline void intrusive_ptr_release(const hybrid_arc_base_t<T> *ptr) noexcept {
+    auto &counter = ptr->counter;
+    if (!ptr->shared) {
+        auto value = counter.load(std::memory_order_relaxed) - 1;
+        counter.store(value, std::memory_order_relaxed);
+        if (value) {
+            return;
+        }
+    } else {
+        if (counter.fetch_sub(1, std::memory_order_release) != 1) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    delete static_cast<const T *>(ptr);
+}
+
+/** \brief base class to inject ref-counter into messages */
+template <typename T> using message_arc_base_t = hybrid_arc_base_t<T>;
+
+#else
+
+/** \brief base class to inject ref-counter into messages */
+template <typename T> using message_arc_base_t = arc_base_t<T>;
+
+#endif
+
 } // namespace rotor
@@ -12,7 +12,6 @@
 #include "system_context_asio.h"
 #include "forwarder.hpp"
 #include <boost/asio.hpp>
-#include <unordered_map>
 #include <memory>
 
 #if defined(_MSC_VER)
@@ -69,6 +68,7 @@ struct ROTOR_ASIO_API supervisor_asio_t : public supervisor_t {
     virtual void start() noexcept override;
     virtual void shutdown() noexcept override;
     virtual void enqueue(message_ptr_t message) noexcept override;
+    virtual void enqueue_batch(message_base_t *first) noexcept override;
     virtual void shutdown_finish() noexcept override;
 
     /** \brief an helper for creation {@link forwarder_t} */
@@ -89,26 +89,20 @@ struct ROTOR_ASIO_API supervisor_asio_t : public supervisor_t {
     void do_process() noexcept;
 
   protected:
-    /** \struct timer_t
-     * \brief boos::asio::deadline_timer with embedded timer handler */
-    struct timer_t : public asio::deadline_timer {
+    /** \brief native timer type, armed to the earliest deadline of the timers queue */
+    using timer_t = asio::basic_waitable_timer<timer_clock_t>;
 
-        /** \brief non-owning pointer to timer handler */
-        timer_handler_base_t *handler;
-
-        /** \brief constructs timer using timer handler and boost asio io_context */
-        timer_t(timer_handler_base_t *handler_, asio::io_context &io_context)
-            : asio::deadline_timer(io_context), handler{handler_} {}
-    };
+    void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
 
-    /** \brief unique pointer to timer */
-    using timer_ptr_t = std::unique_ptr<timer_t>;
+    /** \brief defers `do_process` invocation on the strand (wake-up) */
+    void schedule_process() noexcept;
 
-    /** \brief timer id to timer pointer mapping type */
-    using timers_map_t = std::unordered_map<request_id_t, timer_ptr_t>;
+    /** \brief (re-)arms the native timer to the earliest deadline or cancels it if there are no timers */
+    void arm_timer() noexcept;
 
-    void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
-    void do_cancel_timer(request_id_t timer_id) noexcept override;
+    /** \brief triggers expired timers and processes messages (native timer callback, in strand) */
+    void on_timer() noexcept;
 
     /** \brief guard type : alias for asio executor_work_guard */
     using guard_t = asio::executor_work_guard<asio::io_context::executor_type>;
@@ -116,12 +110,12 @@ struct ROTOR_ASIO_API supervisor_asio_t : public supervisor_t {
     /** \brief alias for a guard */
     using guard_ptr_t = std::unique_ptr<guard_t>;
 
-    /** \brief timer id to timer pointer mapping */
-    timers_map_t timers_map;
-
     /** \brief config for the supervisor */
     supervisor_config_asio_t::strand_ptr_t strand;
 
+    /** \brief the single native timer of the supervisor */
+    timer_t timer;
+
     /** \brief guard to control ownership of the io-context */
     guard_ptr_t guard;
 
@@ -0,0 +1,25 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/** \file coro.hpp
+ * A convenience header to include rotor support for C++20 coroutines
+ */
+
+#if !defined(__cpp_impl_coroutine)
+#error "rotor coroutines support requires C++20 compiler"
+#endif
+
+#include "rotor/coro/task.h"
+#include "rotor/coro/actor.h"
+
+namespace rotor {
+
+/// namespace for C++20 coroutines support for `rotor`
+namespace coro {}
+
+} // namespace rotor
@@ -0,0 +1,242 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "task.h"
+#include <vector>
+
+namespace rotor::coro {
+
+struct actor_t;
+
+/** \struct awaiting_t
+ *  \brief the suspended coroutine, which awaits the response
+ *
+ * It is the sink (see `response_sink_t`) of the request, i.e. the supervisor
+ * hands the response right to the coroutine without any lookup. The awaiting
+ * coroutines of an actor are linked into intrusive list, so that they can be
+ * destroyed upon actor shutdown.
+ *
+ */
+struct awaiting_t : response_sink_t {
+    /** \brief stores the response, unlinks and resumes the coroutine */
+    void on_response(request_id_t, message_base_t &message) noexcept override {
+        response = &message;
+        unlink();
+        handle.resume();
+    }
+
+    /** \brief removes the coroutine from the list of actor's awaiting ones */
+    void unlink() noexcept {
+        prev->next = next;
+        next->prev = prev;
+    }
+
+    /** \brief the id of the request */
+    request_id_t request_id = 0;
+
+    /** \brief suspended coroutine */
+    std::coroutine_handle<> handle = {};
+
+    /** \brief the response message, when it arrives */
+    message_ptr_t response = {};
+
+    /** \brief previous awaiting coroutine of the actor */
+    awaiting_t *prev = nullptr;
+
+    /** \brief next awaiting coroutine of the actor */
+    awaiting_t *next = nullptr;
+};
+
+/** \struct response_awaiter_t
+ *  \brief awaits the response to the request
+ *
+ * The request is dispatched when the coroutine is suspended, and the coroutine
+ * is resumed with the response message, which might carry an error (e.g.
+ * `request_timeout`).
+ *
+ */
+template <typename T> struct [[nodiscard]] response_awaiter_t : awaiting_t {
+    /** \brief response message type */
+    using response_message_t = typename request_traits_t<T>::response::message_t;
+
+    /** \brief intrusive pointer to response message type */
+    using response_ptr_t = intrusive_ptr_t<response_message_t>;
+
+    /** \brief records the actor, the request and its timeout */
+    response_awaiter_t(actor_t &actor_, request_builder_t<T> &&builder_, const pt::time_duration &timeout_,
+                       bool routed_) noexcept
+        : actor{actor_}, builder{std::move(builder_)}, timeout{timeout_}, routed{routed_} {}
+
+    /** \brief the response never arrives immediately */
+    bool await_ready() const noexcept { return false; }
+
+    /** \brief dispatches the request with the awaiter as the response sink */
+    inline void await_suspend(std::coroutine_handle<> handle) noexcept;
+
+    /** \brief hands the response message over to the coroutine */
+    response_ptr_t await_resume() noexcept {
+        return response_ptr_t(static_cast<response_message_t *>(response.detach()), false);
+    }
+
+    /** \brief the actor, on which behalf the request has been made */
+    actor_t &actor;
+
+    /** \brief the request to be dispatched */
+    request_builder_t<T> builder;
+
+    /** \brief the request timeout */
+    pt::time_duration timeout;
+
+    /** \brief whether the response address of the actor is already known */
+    bool routed;
+};
+
+/** \struct awaitable_request_t
+ *  \brief the request builder of coroutine actor; `send` returns awaiter of the response
+ */
+template <typename T> struct [[nodiscard]] awaitable_request_t {
+    /** \brief sets time-to-live of the request message (see `request_builder_t::ttl`) */
+    awaitable_request_t &ttl(const pt::time_duration &value) noexcept {
+        builder.ttl(value);
+        return *this;
+    }
+
+    /** \brief returns the awaiter of the response; the request is dispatched upon `co_await` */
+    response_awaiter_t<T> send(const pt::time_duration &timeout) noexcept {
+        return response_awaiter_t<T>(actor, std::move(builder), timeout, routed);
+    }
+
+    /** \brief the actor, on which behalf the request is made */
+    actor_t &actor;
+
+    /** \brief the underlying request builder */
+    request_builder_t<T> builder;
+
+    /** \brief whether the response address of the actor is already known */
+    bool routed;
+};
+
+/** \struct actor_t
+ *  \brief actor with coroutine (C++20) request/response API
+ *
+ * Within a coroutine (`task_t`) of the actor, a request can be awaited:
+ *
+ * ~~~{.cpp}
+ * task_t my_actor_t::flow() noexcept {
+ *     auto res = co_await request<payload::foo_t>(foo_addr, 5).send(timeout);
+ *     if (res->payload.ee) { ... }
+ * }
+ * ~~~
+ *
+ * The successful response is handed by the supervisor directly to the awaiting
+ * coroutine (see `awaiting_t`), so it is resumed without dispatching the response
+ * the second time. The error (timeout) responses are delivered to the dedicated
+ * address of the actor.
+ *
+ * The coroutines, which still await responses, are destroyed upon
+ * actor shutdown finish (i.e. they are never resumed).
+ *
+ */
+struct actor_t : actor_base_t {
+    /** \brief constructs actor with empty list of awaiting coroutines */
+    actor_t(config_t &config) noexcept : actor_base_t(config) { awaiting.prev = awaiting.next = &awaiting; }
+
+    /** \brief makes a request to the destination address, which response is awaitable
+     *
+     * It hides `actor_base_t::request`; the latter is still available when qualified.
+     *
+     */
+    template <typename Request, typename... Args>
+    awaitable_request_t<typename request_wrapper_t<Request>::request_t> request(const address_ptr_t &dest_addr,
+                                                                              Args &&...args) {
+        using request_t = typename request_wrapper_t<Request>::request_t;
+        using response_message_t = typename request_traits_t<request_t>::response::message_t;
+        using builder_t = request_builder_t<request_t>;
+        auto &route = response_route<response_message_t>();
+        if (route.address) {
+            auto &sup = *supervisor;
+            return {*this, builder_t(route.address, sup, *this, dest_addr, coro_address, std::forward<Args>(args)...),
+                    true};
+        }
+        return {*this, supervisor->do_request<request_t>(*this, dest_addr, coro_address, std::forward<Args>(args)...),
+                false};
+    }
+
+    /** \brief destroys coroutines, which still await responses */
+    void shutdown_finish() noexcept override {
+        while (awaiting.next != &awaiting) {
+            auto it = awaiting.next;
+            it->unlink();
+            it->handle.destroy();
+        }
+        actor_base_t::shutdown_finish();
+    }
+
+  protected:
+    /** \brief resumes the coroutine, which awaits the error response (the request is already discarded) */
+    void on_error_response(request_id_t request_id, message_base_t &response) noexcept {
+        for (auto it = awaiting.next; it != &awaiting; it = it->next) {
+            if (it->request_id == request_id) {
+                it->on_response(request_id, response);
+                return;
+            }
+        }
+    }
+
+    /** \struct response_route_t
+     *  \brief the addresses of the response type
+     */
+    struct response_route_t {
+        /** \brief the response message type */
+        const void *type;
+
+        /** \brief the address, where the supervisor routes the responses to the sinks (once known) */
+        address_ptr_t address;
+    };
+
+    /** \brief returns the route of the response type, lazily subscribes `coro_address` to the error responses */
+    template <typename M> response_route_t &response_route() noexcept {
+        auto type = M::message_type;
+        for (auto &route : coro_responses) {
+            if (route.type == type) {
+                return route;
+            }
+        }
+        if (!coro_address) {
+            coro_address = create_address();
+        }
+        auto handler = [this](M &msg) { on_error_response(msg.payload.request_id(), msg); };
+        subscribe(lambda<M>(std::move(handler)), coro_address);
+        return coro_responses.emplace_back(response_route_t{type, {}});
+    }
+
+    /** \brief the address for error responses */
+    address_ptr_t coro_address;
+
+    /** \brief the routes of the response types (the types are subscribed on `coro_address`) */
+    std::vector<response_route_t> coro_responses;
+
+    /** \brief the head of the list of the coroutines, which await responses */
+    awaiting_t awaiting;
+
+    template <typename T> friend struct response_awaiter_t;
+};
+
+template <typename T> void response_awaiter_t<T>::await_suspend(std::coroutine_handle<> handle_) noexcept {
+    handle = handle_;
+    prev = actor.awaiting.prev;
+    next = &actor.awaiting;
+    prev->next = next->prev = this;
+    request_id = builder.sink(*this).send(timeout);
+    if (!routed) {
+        // the response handler is installed upon the first request sending
+        actor.template response_route<response_message_t>().address = builder.get_response_address();
+    }
+}
+
+} // namespace rotor::coro
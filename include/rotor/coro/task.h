@@ -0,0 +1,86 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/supervisor.h"
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+
+namespace rotor::coro {
+
+/** \struct task_t
+ *  \brief the return type of an actor coroutine
+ *
+ * The coroutine starts immediately (in the context of the caller) and runs
+ * until the first suspension, i.e. until it awaits a response. It is resumed
+ * in the context of the actor's locality, and the frame is released upon
+ * the coroutine completion.
+ *
+ * When the coroutine is a member of an actor (or the actor is the first argument),
+ * the frame is allocated from the recycling allocator of the actor's supervisor
+ * (`supervisor_t::get_frame_pool`).
+ *
+ * The coroutine is not supposed to throw exceptions.
+ *
+ */
+struct task_t {};
+
+namespace detail {
+
+/** \brief returns the frame pool of the actor's supervisor, if the first coroutine argument is an actor */
+template <typename... Args> rotor::detail::frame_pool_t *frame_pool_of(Args &...) noexcept { return nullptr; }
+
+/** \brief returns the frame pool of the actor's supervisor */
+template <typename Actor, typename... Args>
+std::enable_if_t<std::is_base_of_v<actor_base_t, Actor>, rotor::detail::frame_pool_t *>
+frame_pool_of(Actor &self, Args &...) noexcept {
+    return &self.get_supervisor().get_frame_pool();
+}
+
+/** \struct promise_t
+ *  \brief coroutine promise of the fire-and-forget actor task
+ *
+ * The promise is parametrized by the coroutine arguments (see `std::coroutine_traits`
+ * specialization below), so the frame allocation function is not a template; this
+ * lets compilers pair it with the deallocation function.
+ *
+ */
+template <typename... Args> struct promise_t {
+    /** \brief returns the (empty) task */
+    task_t get_return_object() noexcept { return {}; }
+
+    /** \brief the coroutine starts immediately */
+    std::suspend_never initial_suspend() noexcept { return {}; }
+
+    /** \brief the frame is released upon completion */
+    std::suspend_never final_suspend() noexcept { return {}; }
+
+    /** \brief no-op */
+    void return_void() noexcept {}
+
+    /** \brief the coroutines are noexcept */
+    void unhandled_exception() noexcept { std::terminate(); }
+
+    /** \brief allocates the frame from the supervisor's pool of the actor (if any) */
+    static void *operator new(std::size_t size, std::remove_reference_t<Args> &...args) {
+        return rotor::detail::frame_pool_t::allocate(frame_pool_of(args...), size);
+    }
+
+    /** \brief releases the frame */
+    static void operator delete(void *ptr) noexcept { rotor::detail::frame_pool_t::deallocate(ptr); }
+};
+
+} // namespace detail
+
+} // namespace rotor::coro
+
+/** \brief `rotor::coro::task_t` coroutine promise type */
+template <typename... Args> struct std::coroutine_traits<rotor::coro::task_t, Args...> {
+    /** \brief the promise type, which knows the coroutine arguments */
+    using promise_type = rotor::coro::detail::promise_t<Args...>;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include <cassert>
+#include <cstddef>
+#include <new>
+
+namespace rotor::detail {
+
+/** \struct frame_pool_t
+ *  \brief size-class recycling allocator of a supervisor (e.g. for coroutine frames)
+ *
+ * Unlike `message_pool_t`, the blocks are allocated and released only in the
+ * context of the owning supervisor, so there is no synchronization at all.
+ * Up to `capacity` freed blocks per size class are cached for reuse.
+ *
+ * Every block is prepended with a small header, which records the owning pool
+ * (or `nullptr` for the blocks, allocated on heap), so a block can be released
+ * without knowing the pool. The pool must outlive all its blocks.
+ *
+ */
+struct frame_pool_t {
+    /** \brief amount of size classes */
+    static constexpr std::size_t size_classes = 6;
+
+    /** \brief the smallest block size; each next size class doubles it */
+    static constexpr std::size_t min_block_size = 128;
+
+    /** \brief constructs pool, which caches at most `capacity` blocks per size class */
+    explicit frame_pool_t(std::size_t capacity_ = 64) noexcept : capacity{capacity_} {}
+
+    frame_pool_t(const frame_pool_t &) = delete;
+    frame_pool_t(frame_pool_t &&) = delete;
+
+    ~frame_pool_t() {
+        assert(!live && "all blocks are released");
+        for (auto block : free_lists) {
+            while (block) {
+                auto next = block->next;
+                ::operator delete(block);
+                block = next;
+            }
+        }
+    }
+
+    /** \brief allocates `size` bytes from the pool, or from heap if the `pool` is `nullptr` */
+    static void *allocate(frame_pool_t *pool, std::size_t size) {
+        if (pool) {
+            return pool->allocate_block(size);
+        }
+        auto block = static_cast<block_t *>(::operator new(sizeof(block_t) + size));
+        block->pool = nullptr;
+        block->size_class = size_classes;
+        return block + 1;
+    }
+
+    /** \brief releases memory, previously obtained via `allocate` */
+    static void deallocate(void *ptr) noexcept {
+        auto block = static_cast<block_t *>(ptr) - 1;
+        auto pool = block->pool;
+        if (!pool) {
+            ::operator delete(block);
+        } else {
+            pool->release(block);
+        }
+    }
+
+    /** \brief amount of allocations served from the free lists */
+    inline std::size_t hits() const noexcept { return hits_count; }
+
+    /** \brief amount of allocations served from the heap */
+    inline std::size_t misses() const noexcept { return misses_count; }
+
+  private:
+    struct alignas(std::max_align_t) block_t {
+        union {
+            frame_pool_t *pool; /* when allocated */
+            block_t *next;      /* when cached */
+        };
+        std::size_t size_class;
+    };
+
+    void *allocate_block(std::size_t size) {
+        auto block_size = min_block_size;
+        std::size_t size_class = 0;
+        while (size_class < size_classes && block_size < size) {
+            block_size <<= 1;
+            ++size_class;
+        }
+        if (size_class == size_classes) {
+            ++misses_count;
+            return allocate(nullptr, size);
+        }
+
+        auto block = free_lists[size_class];
+        if (block) {
+            free_lists[size_class] = block->next;
+            --free_counts[size_class];
+            ++hits_count;
+        } else {
+            block = static_cast<block_t *>(::operator new(sizeof(block_t) + block_size));
+            block->size_class = size_class;
+            ++misses_count;
+        }
+        block->pool = this;
+        ++live;
+        return block + 1;
+    }
+
+    void release(block_t *block) noexcept {
+        --live;
+        auto size_class = block->size_class;
+        if (free_counts[size_class] < capacity) {
+            block->next = free_lists[size_class];
+            free_lists[size_class] = block;
+            ++free_counts[size_class];
+        } else {
+            ::operator delete(block);
+        }
+    }
+
+    block_t *free_lists[size_classes] = {};
+    std::size_t free_counts[size_classes] = {};
+    std::size_t capacity;
+    std::size_t live = 0;
+    std::size_t hits_count = 0;
+    std::size_t misses_count = 0;
+};
+
+} // namespace rotor::detail
@@ -0,0 +1,170 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/request.hpp"
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+
+namespace rotor::detail {
+
+/** \struct request_list_t
+ *  \brief intrusive list of the pending requests of an actor
+ *
+ * The list nodes are the slots of `request_table_t`, i.e. tracking of
+ * actor's requests does not allocate.
+ *
+ */
+struct request_list_t {
+    /** \brief whether there are no pending requests */
+    inline bool empty() const noexcept { return count == 0; }
+
+    /** \brief amount of pending requests */
+    inline std::size_t size() const noexcept { return count; }
+
+    /** \brief id of the most recent pending request (the list must not be empty) */
+    inline request_id_t front() const noexcept { return first; }
+
+  private:
+    request_id_t first = 0;
+    std::size_t count = 0;
+
+    friend struct request_table_t;
+};
+
+/** \struct request_table_t
+ *  \brief generational slot map of the pending requests
+ *
+ * The request id is generated by the table: it encodes the slot index and the
+ * generation of the slot, so lookup, insertion and removal are just array indexing,
+ * and the id of a finished request is not recognized even if its slot is reused.
+ * The ids have the highest bit set, i.e. they never clash with timer ids, which
+ * come from the plain counter.
+ *
+ * The id bits are split in halves: the lower half is the slot index, the upper half (but
+ * the highest bit) is the generation. I.e. the table holds up to `max_size` pending requests:
+ * `2^32 - 1` with 64-bit `request_id_t`, but only `65535` with 32-bit one.
+ *
+ * The freed slots are reused, and the slots storage never moves the slots
+ * (the addresses of the curries are stable), hence the table does not allocate
+ * in the steady state.
+ *
+ */
+struct request_table_t {
+    /** \brief returns the curry of the pending request, or `nullptr` if it is not found */
+    inline request_curry_t *find(request_id_t id) noexcept {
+        auto index = index_of(id);
+        if (index < slots.size() && slots[index].id == id) {
+            return &slots[index].curry;
+        }
+        return nullptr;
+    }
+
+    /** \brief whether the request is pending */
+    inline bool contains(request_id_t id) const noexcept {
+        auto index = index_of(id);
+        return index < slots.size() && slots[index].id == id;
+    }
+
+    /** \brief records the request curry, links it to the actor's requests list and returns the request id */
+    request_id_t emplace(request_curry_t &&curry, request_list_t &list) noexcept {
+        index_t index;
+        if (free_head != npos) {
+            index = free_head;
+            free_head = slots[index].next;
+        } else {
+            assert(slots.size() < max_size && "too many pending requests");
+            index = static_cast<index_t>(slots.size());
+            slots.emplace_back();
+        }
+        auto &slot = slots[index];
+        slot.id = make_id(index, slot.generation);
+        slot.curry = std::move(curry);
+        slot.list = &list;
+        slot.prev = npos;
+        slot.next = list.count ? index_of(list.first) : npos;
+        if (slot.next != npos) {
+            slots[slot.next].prev = index;
+        }
+        list.first = slot.id;
+        ++list.count;
+        ++count;
+        return slot.id;
+    }
+
+    /** \brief forgets the pending request (it must be present in the table) */
+    void erase(request_id_t id) noexcept {
+        auto index = index_of(id);
+        assert(index < slots.size() && slots[index].id == id && "request is pending");
+        auto &slot = slots[index];
+        auto &list = *slot.list;
+        if (slot.prev != npos) {
+            slots[slot.prev].next = slot.next;
+        } else {
+            list.first = slot.next != npos ? slots[slot.next].id : 0;
+        }
+        if (slot.next != npos) {
+            slots[slot.next].prev = slot.prev;
+        }
+        --list.count;
+        --count;
+
+        slot.curry = request_curry_t{};
+        slot.list = nullptr;
+        slot.id = 0;
+        slot.generation = (slot.generation + 1) & generation_mask;
+        slot.prev = npos;
+        slot.next = free_head;
+        free_head = index;
+    }
+
+    /** \brief amount of pending requests */
+    inline std::size_t size() const noexcept { return count; }
+
+    /** \brief whether there are no pending requests */
+    inline bool empty() const noexcept { return count == 0; }
+
+    /** \brief the maximum amount of pending requests (i.e. slots) */
+    static constexpr std::size_t max_size =
+        (std::size_t{1} << (std::numeric_limits<request_id_t>::digits / 2)) - 1;
+
+  private:
+    using index_t = std::uint32_t;
+
+    static constexpr index_t npos = std::numeric_limits<index_t>::max();
+    static constexpr unsigned id_bits = std::numeric_limits<request_id_t>::digits;
+    static constexpr unsigned index_bits = id_bits / 2;
+    static constexpr request_id_t index_mask = (request_id_t{1} << index_bits) - 1;
+    static constexpr request_id_t generation_mask = (request_id_t{1} << (id_bits - index_bits - 1)) - 1;
+    static constexpr request_id_t tag = request_id_t{1} << (id_bits - 1);
+
+    static_assert(max_size == index_mask, "slot index fits the index bits of request id");
+    static_assert(max_size <= npos, "slot index fits index type");
+
+    struct slot_t {
+        request_curry_t curry = {};
+        request_list_t *list = nullptr;
+        request_id_t id = 0;
+        request_id_t generation = 0;
+        index_t prev = npos;
+        index_t next = npos;
+    };
+
+    static inline index_t index_of(request_id_t id) noexcept { return static_cast<index_t>(id & index_mask); }
+
+    static inline request_id_t make_id(index_t index, request_id_t generation) noexcept {
+        return tag | (generation << index_bits) | index;
+    }
+
+    std::deque<slot_t> slots;
+    index_t free_head = npos;
+    std::size_t count = 0;
+};
+
+} // namespace rotor::detail
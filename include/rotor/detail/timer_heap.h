@@ -0,0 +1,145 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/timer_handler.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rotor::detail {
+
+/** \struct timer_heap_t
+ *  \brief indexed 4-ary min-heap of timer handlers ordered by deadline
+ *
+ * The position of a timer in the heap is stored in the timer handler itself
+ * (`timer_handler_base_t::queue_index`), so a timer can be removed without
+ * searching it: insertion, cancellation and extraction of the earliest timer
+ * are `O(log n)`, peeking the earliest timer is `O(1)`.
+ *
+ * Timers with the same deadline are extracted in the order of insertion.
+ *
+ */
+template <typename TimePoint> struct timer_heap_t {
+    /** \brief heap arity */
+    static constexpr std::size_t arity = 4;
+
+    /** \struct node_t
+     *  \brief heap element
+     */
+    struct node_t {
+        /** \brief time point, after which the timer is considered expired */
+        TimePoint deadline;
+
+        /** \brief insertion sequence number, tie-breaker for equal deadlines */
+        std::uint64_t seq;
+
+        /** \brief non-owning pointer to timer handler */
+        timer_handler_base_t *handler;
+    };
+
+    /** \brief whether there are no timers */
+    inline bool empty() const noexcept { return nodes.empty(); }
+
+    /** \brief amount of timers */
+    inline std::size_t size() const noexcept { return nodes.size(); }
+
+    /** \brief returns the timer with the earliest deadline (the heap must not be empty) */
+    inline const node_t &top() const noexcept { return nodes.front(); }
+
+    /** \brief inserts timer handler with the deadline */
+    void push(timer_handler_base_t &handler, const TimePoint &deadline) noexcept {
+        auto index = nodes.size();
+        nodes.emplace_back(node_t{deadline, seq++, &handler});
+        handler.queue_index = index;
+        sift_up(index);
+    }
+
+    /** \brief removes the timer with the earliest deadline and returns its handler */
+    timer_handler_base_t *pop() noexcept {
+        auto handler = nodes.front().handler;
+        remove(0);
+        return handler;
+    }
+
+    /** \brief removes the timer handler from the heap */
+    void erase(timer_handler_base_t &handler) noexcept {
+        auto index = handler.queue_index;
+        assert(index < nodes.size() && nodes[index].handler == &handler && "timer is in the heap");
+        remove(index);
+    }
+
+  private:
+    static inline bool less(const node_t &a, const node_t &b) noexcept {
+        return a.deadline < b.deadline || (!(b.deadline < a.deadline) && a.seq < b.seq);
+    }
+
+    inline void place(std::size_t index, node_t &&node) noexcept {
+        node.handler->queue_index = index;
+        nodes[index] = std::move(node);
+    }
+
+    void remove(std::size_t index) noexcept {
+        nodes[index].handler->queue_index = timer_handler_base_t::npos;
+        auto last = nodes.size() - 1;
+        if (index != last) {
+            place(index, std::move(nodes[last]));
+            nodes.pop_back();
+            if (index > 0 && less(nodes[index], nodes[(index - 1) / arity])) {
+                sift_up(index);
+            } else {
+                sift_down(index);
+            }
+        } else {
+            nodes.pop_back();
+        }
+    }
+
+    void sift_up(std::size_t index) noexcept {
+        auto node = std::move(nodes[index]);
+        while (index > 0) {
+            auto parent = (index - 1) / arity;
+            if (!less(node, nodes[parent])) {
+                break;
+            }
+            place(index, std::move(nodes[parent]));
+            index = parent;
+        }
+        place(index, std::move(node));
+    }
+
+    void sift_down(std::size_t index) noexcept {
+        auto count = nodes.size();
+        auto node = std::move(nodes[index]);
+        while (true) {
+            auto first_child = index * arity + 1;
+            if (first_child >= count) {
+                break;
+            }
+            auto last_child = std::min(first_child + arity, count);
+            auto best = first_child;
+            for (auto child = first_child + 1; child < last_child; ++child) {
+                if (less(nodes[child], nodes[best])) {
+                    best = child;
+                }
+            }
+            if (!less(nodes[best], node)) {
+                break;
+            }
+            place(index, std::move(nodes[best]));
+            index = best;
+        }
+        place(index, std::move(node));
+    }
+
+    std::vector<node_t> nodes;
+    std::uint64_t seq = 0;
+};
+
+} // namespace rotor::detail
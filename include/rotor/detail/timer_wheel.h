@@ -0,0 +1,155 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/forward.hpp"
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace rotor::detail {
+
+/** \struct wheel_hook_t
+ *  \brief intrusive node of the timer wheel, embedded into the timed entity
+ */
+struct wheel_hook_t {
+    /** \brief previous node in the wheel slot */
+    wheel_hook_t *prev = nullptr;
+
+    /** \brief next node in the wheel slot */
+    wheel_hook_t *next = nullptr;
+
+    /** \brief the wheel tick, at which the node expires; zero means not in the wheel */
+    std::uint64_t tick = 0;
+
+    /** \brief the identity of the timed entity */
+    request_id_t id = 0;
+};
+
+/** \struct timer_wheel_t
+ *  \brief coarse-grained hashed timer wheel of intrusive nodes
+ *
+ * The time is split into ticks of the fixed resolution, the wheel slot of
+ * a node is determined by the tick of its deadline (rounded up). Insertion and
+ * removal are `O(1)` and do not allocate; the expired nodes are collected by
+ * `advance`, which visits only the slots of the passed ticks.
+ *
+ * A node never expires earlier than its deadline, but it might expire up
+ * to one tick later (plus the delay of the `advance` invocation).
+ *
+ */
+template <typename TimePoint, std::size_t Slots = 256> struct timer_wheel_t {
+    /** \brief the duration type of the wheel tick */
+    using duration_t = typename TimePoint::duration;
+
+    /** \brief constructs the wheel with the tick resolution, starting at the `origin` time point */
+    timer_wheel_t(const duration_t &resolution_, const TimePoint &origin_) noexcept
+        : resolution{resolution_}, origin{origin_} {
+        assert(resolution.count() > 0 && "positive wheel resolution");
+    }
+
+    /** \brief whether there are no nodes */
+    inline bool empty() const noexcept { return count == 0; }
+
+    /** \brief amount of nodes */
+    inline std::size_t size() const noexcept { return count; }
+
+    /** \brief inserts the node, which expires at the deadline */
+    void push(wheel_hook_t &hook, const TimePoint &deadline) noexcept {
+        assert(!hook.tick && "node is not in the wheel");
+        auto tick = ticks(deadline);
+        if ((origin + resolution * static_cast<typename duration_t::rep>(tick)) < deadline) {
+            ++tick;
+        }
+        hook.tick = tick > current ? tick : current + 1;
+        auto &head = slots[hook.tick % Slots];
+        hook.prev = nullptr;
+        hook.next = head;
+        if (head) {
+            head->prev = &hook;
+        }
+        head = &hook;
+        ++count;
+    }
+
+    /** \brief removes the node from the wheel */
+    void erase(wheel_hook_t &hook) noexcept {
+        assert(hook.tick && "node is in the wheel");
+        unlink(hook);
+        --count;
+    }
+
+    /** \brief removes the nodes, expired at the `now` time point, and invokes `fn(hook)` for each of them
+     *
+     * The node is already removed from the wheel, when `fn` is invoked, so it might be destroyed
+     * by `fn`. Returns the amount of expired nodes.
+     *
+     */
+    template <typename Fn> std::size_t advance(const TimePoint &now, Fn &&fn) noexcept {
+        auto target = ticks(now);
+        if (target <= current) {
+            return 0;
+        }
+        auto steps = target - current;
+        if (steps > Slots) {
+            steps = Slots;
+        }
+        wheel_hook_t *expired = nullptr;
+        for (std::uint64_t i = 1; i <= steps; ++i) {
+            auto hook = slots[(current + i) % Slots];
+            while (hook) {
+                auto next = hook->next;
+                if (hook->tick <= target) {
+                    unlink(*hook);
+                    hook->next = expired;
+                    expired = hook;
+                }
+                hook = next;
+            }
+        }
+        current = target;
+
+        std::size_t expired_count = 0;
+        while (expired) {
+            auto next = expired->next;
+            --count;
+            ++expired_count;
+            fn(*expired);
+            expired = next;
+        }
+        return expired_count;
+    }
+
+  private:
+    inline std::uint64_t ticks(const TimePoint &time_point) const noexcept {
+        if (time_point < origin) {
+            return 0;
+        }
+        return static_cast<std::uint64_t>((time_point - origin) / resolution);
+    }
+
+    inline void unlink(wheel_hook_t &hook) noexcept {
+        if (hook.prev) {
+            hook.prev->next = hook.next;
+        } else {
+            slots[hook.tick % Slots] = hook.next;
+        }
+        if (hook.next) {
+            hook.next->prev = hook.prev;
+        }
+        hook.prev = hook.next = nullptr;
+        hook.tick = 0;
+    }
+
+    duration_t resolution;
+    TimePoint origin;
+    std::uint64_t current = 0;
+    std::size_t count = 0;
+    std::array<wheel_hook_t *, Slots> slots = {};
+};
+
+} // namespace rotor::detail
@@ -0,0 +1,22 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/** \file epoll.hpp
+ * A convenience header to include rotor support for epoll backend
+ */
+
+#include "rotor/epoll/messages.hpp"
+#include "rotor/epoll/supervisor_epoll.h"
+#include "rotor/epoll/system_context_epoll.h"
+
+namespace rotor {
+
+/// namespace for epoll backend (Linux) for `rotor`
+namespace epoll {}
+
+} // namespace rotor
@@ -0,0 +1,44 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/message.h"
+#include <cstdint>
+
+namespace rotor {
+namespace epoll {
+
+/// namespace for epoll backend payloads
+namespace payload {
+
+/** \struct fd_ready_t
+ *  \brief the watched file descriptor became ready
+ *
+ * After the delivery the watch is disarmed, until it is re-armed via
+ * `supervisor_epoll_t::rearm_fd`.
+ *
+ */
+struct fd_ready_t {
+    /** \brief the watched file descriptor */
+    int fd;
+
+    /** \brief epoll events mask (`EPOLLIN`, `EPOLLOUT`, `EPOLLERR`, `EPOLLHUP` etc.) */
+    std::uint32_t events;
+};
+
+} // namespace payload
+
+/// namespace for epoll backend messages
+namespace message {
+
+/** \brief file descriptor readiness notification */
+using fd_ready_t = message_t<payload::fd_ready_t>;
+
+} // namespace message
+
+} // namespace epoll
+} // namespace rotor
@@ -0,0 +1,146 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/supervisor.h"
+#include "rotor/epoll/export.h"
+#include "rotor/epoll/messages.hpp"
+#include "rotor/epoll/system_context_epoll.h"
+#include <memory>
+#include <unordered_map>
+
+namespace rotor {
+namespace epoll {
+
+/** \struct supervisor_epoll_t
+ *  \brief delivers rotor-messages on top of epoll event loop (Linux only)
+ *
+ * The supervisor uses `eventfd` for the wake-ups upon messages from other
+ * threads, and single `timerfd`, which is armed to the earliest deadline
+ * of the supervisor timers.
+ *
+ * Besides that, the actors might watch readiness of file descriptors: upon
+ * readiness, the {@link message::fd_ready_t} is delivered to the specified
+ * address, and the watch is disarmed until it is re-armed.
+ *
+ * All supervisors of the same {@link system_context_epoll_t} are executed on
+ * the loop thread.
+ *
+ */
+struct ROTOR_EPOLL_API supervisor_epoll_t : public supervisor_t {
+    /** \brief constructs new epoll supervisor */
+    supervisor_epoll_t(supervisor_config_t &config);
+    ~supervisor_epoll_t();
+
+    virtual void do_initialize(system_context_t *ctx) noexcept override;
+    void start() noexcept override;
+    void shutdown() noexcept override;
+    void enqueue(message_ptr_t message) noexcept override;
+    void enqueue_batch(message_base_t *first) noexcept override;
+    void shutdown_finish() noexcept override;
+
+    /** \brief starts watching the file descriptor events (e.g. `EPOLLIN`, `EPOLLOUT`)
+     *
+     * The readiness is delivered to the destination address once, see `rearm_fd`.
+     *
+     */
+    std::error_code watch_fd(const address_ptr_t &destination, int fd, std::uint32_t events) noexcept;
+
+    /** \brief re-arms the watch after readiness delivery */
+    std::error_code rearm_fd(int fd) noexcept;
+
+    /** \brief stops watching the file descriptor */
+    void unwatch_fd(int fd) noexcept;
+
+    /** \brief returns pointer to the epoll system context */
+    inline system_context_epoll_t *get_context() noexcept { return static_cast<system_context_epoll_t *>(context); }
+
+  protected:
+    /** \struct fd_watcher_t
+     *  \brief the watch of actor's file descriptor
+     */
+    struct fd_watcher_t : watcher_t {
+        /** \brief the watched file descriptor */
+        int fd;
+
+        /** \brief the watched events */
+        std::uint32_t events;
+
+        /** \brief where the readiness will be delivered */
+        address_ptr_t destination;
+    };
+
+    /** \brief unique pointer to file descriptor watch */
+    using fd_watcher_ptr_t = std::unique_ptr<fd_watcher_t>;
+
+    /** \brief file descriptor watches (type) */
+    using fd_watchers_t = std::unordered_map<int, fd_watcher_ptr_t>;
+
+    /** \brief trampoline function for `on_async` method */
+    static void async_cb(watcher_t &watcher, std::uint32_t events) noexcept;
+
+    /** \brief trampoline function for `on_timer` method */
+    static void timer_cb(watcher_t &watcher, std::uint32_t events) noexcept;
+
+    /** \brief trampoline function for `on_fd` method */
+    static void fd_cb(watcher_t &watcher, std::uint32_t events) noexcept;
+
+    void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
+
+    /** \brief Process external messages (from inbound queue).
+     *
+     * Used for moving messages in a thread-safe way for the supervisor
+     * from external (inbound) queue into internal queue and do further
+     * processing / delivery of the messages.
+     *
+     */
+    virtual void on_async() noexcept;
+
+    /** \brief triggers expired timers and processes messages (timerfd callback) */
+    void on_timer() noexcept;
+
+    /** \brief delivers file descriptor readiness and processes messages */
+    void on_fd(fd_watcher_t &watcher, std::uint32_t events) noexcept;
+
+    /** \brief (re-)arms the timerfd to the earliest deadline or disarms it if there are no timers
+     *
+     * The supervisor is kept alive (referenced) while the timer is armed.
+     *
+     */
+    void arm_timer() noexcept;
+
+    /** \brief wakes up the loop (from any thread) */
+    void wakeup() noexcept;
+
+    /** \brief watcher of the wake-ups */
+    watcher_t async_watcher;
+
+    /** \brief watcher of the timer */
+    watcher_t timer_watcher;
+
+    /** \brief wake-up notifier */
+    int event_fd = -1;
+
+    /** \brief the single native timer of the supervisor */
+    int timer_fd = -1;
+
+    /** \brief whether the timer is armed */
+    bool timer_armed = false;
+
+    /** \brief whether the fds are registered in epoll */
+    bool registered = false;
+
+    /** \brief file descriptor watches */
+    fd_watchers_t fd_watchers;
+
+  private:
+    void move_inbound_queue() noexcept;
+};
+
+} // namespace epoll
+} // namespace rotor
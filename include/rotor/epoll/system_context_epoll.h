@@ -0,0 +1,96 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/arc.hpp"
+#include "rotor/system_context.h"
+#include "rotor/epoll/export.h"
+#include <cstdint>
+#include <sys/epoll.h>
+#include <system_error>
+
+namespace rotor {
+namespace epoll {
+
+struct supervisor_epoll_t;
+
+/** \brief intrusive pointer for epoll supervisor */
+using supervisor_ptr_t = intrusive_ptr_t<supervisor_epoll_t>;
+
+/** \struct watcher_t
+ *  \brief the receiver of epoll events of a file descriptor
+ */
+struct watcher_t {
+    /** \brief the events handler (type) */
+    using callback_t = void (*)(watcher_t &watcher, std::uint32_t events) noexcept;
+
+    /** \brief the events handler */
+    callback_t callback;
+
+    /** \brief user-defined data (i.e. the owner) */
+    void *data;
+};
+
+/** \struct system_context_epoll_t
+ *  \brief The epoll system context (Linux only)
+ *
+ * The context owns epoll instance and runs its loop: the events of the
+ * registered file descriptors are dispatched to their watchers, i.e. to
+ * {@link supervisor_epoll_t}, which use `eventfd` for wake-ups and `timerfd`
+ * for timers.
+ *
+ */
+struct ROTOR_EPOLL_API system_context_epoll_t : public system_context_t {
+    /** \brief constructs epoll system context */
+    system_context_epoll_t() noexcept;
+
+    ~system_context_epoll_t();
+
+    /** \brief invokes blocking execution of the supervisor
+     *
+     * It blocks until root supervisor shuts down.
+     *
+     */
+    virtual void run() noexcept;
+
+    /** \brief registers the file descriptor events watcher */
+    std::error_code add(int fd, std::uint32_t events, watcher_t &watcher) noexcept;
+
+    /** \brief changes the watched events of the file descriptor */
+    std::error_code modify(int fd, std::uint32_t events, watcher_t &watcher) noexcept;
+
+    /** \brief unregisters the file descriptor; its pending events will not be dispatched */
+    void remove(int fd, watcher_t &watcher) noexcept;
+
+    /** \brief returns the error of epoll instance creation (if any) */
+    inline const std::error_code &get_error() const noexcept { return ec; }
+
+  protected:
+    /** \brief the maximum amount of events retrieved at once */
+    static constexpr int max_events = 64;
+
+    /** \brief epoll instance */
+    int epoll_fd = -1;
+
+    /** \brief the events being dispatched */
+    epoll_event *dispatched = nullptr;
+
+    /** \brief the index of the event being dispatched */
+    int dispatched_index = 0;
+
+    /** \brief the amount of the events being dispatched */
+    int dispatched_count = 0;
+
+    /** \brief the error of epoll instance creation */
+    std::error_code ec;
+};
+
+/** \brief intrusive pointer type for epoll system context */
+using system_context_ptr_t = rotor::intrusive_ptr_t<system_context_epoll_t>;
+
+} // namespace epoll
+} // namespace rotor
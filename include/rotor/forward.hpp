@@ -14,6 +14,7 @@ namespace rotor {
 struct address_t;
 struct actor_base_t;
 struct handler_base_t;
+struct message_base_t;
 struct supervisor_t;
 struct system_context_t;
 
@@ -25,6 +26,9 @@ using actor_ptr_t = intrusive_ptr_t<actor_base_t>;
 /** \brief intrusive pointer for handler */
 using handler_ptr_t = intrusive_ptr_t<handler_base_t>;
 
+/** \brief devirtualized handler invoker, i.e. delivers the message of the matching type to the handler */
+using handler_thunk_t = void (*)(handler_base_t &, intrusive_ptr_t<message_base_t> &) noexcept;
+
 /** \brief intrusive pointer for supervisor */
 using supervisor_ptr_t = intrusive_ptr_t<supervisor_t>;
 
@@ -128,10 +128,18 @@ struct ROTOR_API handler_base_t : public arc_base_t<handler_base_t> {
     /** \brief precalculated hash for the handler */
     size_t precalc_hash;
 
+    /** \brief invokes the handler for the message of the matching type without virtual call
+     *
+     * The final handlers provide the thunk, which casts to the concrete type and calls
+     * `call_no_check`; by default it is the virtual `call`.
+     */
+    handler_thunk_t thunk;
+
     /** \brief constructs `handler_base_t` from raw pointer to actor, raw
      * pointer to message type and raw pointer to handler type
      */
-    explicit handler_base_t(actor_base_t &actor, const void *handler_type_) noexcept;
+    explicit handler_base_t(actor_base_t &actor, const void *handler_type_,
+                            handler_thunk_t thunk_ = &handler_base_t::virtual_call) noexcept;
 
     /** \brief compare two handler for equality */
     inline bool operator==(const handler_base_t &rhs) const noexcept {
@@ -167,6 +175,9 @@ struct ROTOR_API handler_base_t : public arc_base_t<handler_base_t> {
 
     /** \brief unique per-message-type pointer used for routing */
     virtual const void *message_type() const noexcept = 0;
+
+  private:
+    static void virtual_call(handler_base_t &self, message_ptr_t &message) noexcept;
 };
 
 /** \struct continuation_t
@@ -238,7 +249,7 @@ struct handler_t<Handler, std::enable_if_t<details::is_actor_handler_v<Handler>>
 
     /** \brief constructs handler from actor & pointer-to-member function  */
     explicit handler_t(actor_base_t &actor, Handler &&handler_)
-        : handler_base_t{actor, handler_type}, handler{handler_} {}
+        : handler_base_t{actor, handler_type, &handler_t::invoke}, handler{handler_} {}
 
     void call(message_ptr_t &message) noexcept override {
         if (message->type_index == final_message_t::message_type) {
@@ -261,6 +272,10 @@ struct handler_t<Handler, std::enable_if_t<details::is_actor_handler_v<Handler>>
     const void *message_type() const noexcept override { return final_message_t::message_type; }
 
   private:
+    static void invoke(handler_base_t &self, message_ptr_t &message) noexcept {
+        static_cast<handler_t &>(self).call_no_check(message);
+    }
+
     using traits = handler_traits<Handler>;
     using backend_t = typename traits::backend_t;
     using final_message_t = typename traits::message_t;
@@ -286,7 +301,8 @@ struct handler_t<Handler, std::enable_if_t<details::is_plugin_handler_v<Handler>
 
     /** \brief ctor form plugin and plugin handler (pointer-to-member function of the plugin) */
     explicit handler_t(plugin::plugin_base_t &plugin_, Handler &&handler_)
-        : handler_base_t{*plugin_.access<details::to::actor>(), handler_type}, plugin{plugin_}, handler{handler_} {}
+        : handler_base_t{*plugin_.access<details::to::actor>(), handler_type, &handler_t::invoke}, plugin{plugin_},
+          handler{handler_} {}
 
     void call(message_ptr_t &message) noexcept override {
         if (message->type_index == final_message_t::message_type) {
@@ -309,6 +325,10 @@ struct handler_t<Handler, std::enable_if_t<details::is_plugin_handler_v<Handler>
     const void *message_type() const noexcept override { return final_message_t::message_type; }
 
   private:
+    static void invoke(handler_base_t &self, message_ptr_t &message) noexcept {
+        static_cast<handler_t &>(self).call_no_check(message);
+    }
+
     using traits = handler_traits<Handler>;
     using backend_t = typename traits::backend_t;
     using final_message_t = typename traits::message_t;
@@ -336,7 +356,7 @@ struct handler_t<lambda_holder_t<Handler, M>,
 
     /** \brief constructs handler from actor & lambda wrapper */
     explicit handler_t(actor_base_t &actor, handler_backend_t &&handler_)
-        : handler_base_t{actor, handler_type}, handler{std::forward<handler_backend_t>(handler_)} {}
+        : handler_base_t{actor, handler_type, &handler_t::invoke}, handler{std::forward<handler_backend_t>(handler_)} {}
 
     void call(message_ptr_t &message) noexcept override {
         if (message->type_index == final_message_t::message_type) {
@@ -357,6 +377,10 @@ struct handler_t<lambda_holder_t<Handler, M>,
     const void *message_type() const noexcept override { return final_message_t::message_type; }
 
   private:
+    static void invoke(handler_base_t &self, message_ptr_t &message) noexcept {
+        static_cast<handler_t &>(self).call_no_check(message);
+    }
+
     using final_message_t = typename handler_backend_t::message_t;
 };
 
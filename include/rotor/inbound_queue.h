@@ -0,0 +1,111 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "message.h"
+#include <atomic>
+
+namespace rotor {
+
+/** \struct inbound_queue_t
+ *  \brief unbounded intrusive multi-producer single-consumer queue of messages
+ *
+ * Messages are linked via `message_base_t::next_inbound` pointer, so `push`
+ * never allocates. The consumer detaches all pending messages at once
+ * with a single atomic exchange, and then they are restored in the FIFO
+ * order.
+ *
+ * A message can be present in one inbound queue at a time only. The queue
+ * owns one reference of each pushed message.
+ *
+ */
+struct inbound_queue_t {
+    inbound_queue_t() noexcept : head{nullptr} {}
+    inbound_queue_t(const inbound_queue_t &) = delete;
+    inbound_queue_t(inbound_queue_t &&) = delete;
+    ~inbound_queue_t() { clear(); }
+
+    /** \brief thread-safely pushes the message; returns `true` if the queue was empty */
+    inline bool push(message_base_t *message) noexcept {
+        auto top = head.load(std::memory_order_relaxed);
+        do {
+            message->next_inbound = top;
+        } while (!head.compare_exchange_weak(top, message, std::memory_order_release, std::memory_order_relaxed));
+        return top == nullptr;
+    }
+
+    /** \brief thread-safely pushes the messages linked via `next_inbound` in FIFO order at once;
+     * returns `true` if the queue was empty */
+    inline bool push_batch(message_base_t *first) noexcept {
+        message_base_t *top = nullptr;
+        auto bottom = first;
+        while (first) {
+            auto next = first->next_inbound;
+            first->next_inbound = top;
+            top = first;
+            first = next;
+        }
+        if (!top) {
+            return false;
+        }
+        auto head_top = head.load(std::memory_order_relaxed);
+        do {
+            bottom->next_inbound = head_top;
+        } while (!head.compare_exchange_weak(head_top, top, std::memory_order_release, std::memory_order_relaxed));
+        return head_top == nullptr;
+    }
+
+    /** \brief detaches all pending messages, which are linked in FIFO order (consumer only) */
+    inline message_base_t *pop_all() noexcept {
+        if (!head.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        auto top = head.exchange(nullptr, std::memory_order_acquire);
+        message_base_t *result = nullptr;
+        while (top) {
+            auto next = top->next_inbound;
+            top->next_inbound = result;
+            result = top;
+            top = next;
+        }
+        return result;
+    }
+
+    /** \brief moves all pending messages into the queue (`messages_queue_t` or `message_lanes_t`),
+     * returns the amount of moved messages (consumer only) */
+    template <typename Queue> inline std::size_t drain(Queue &queue) noexcept {
+        std::size_t count = 0;
+        auto message = pop_all();
+        while (message) {
+            auto next = message->next_inbound;
+            message->next_inbound = nullptr;
+            queue.emplace_back(message, false);
+            message = next;
+            ++count;
+        }
+        return count;
+    }
+
+    /** \brief releases all pending messages (consumer only) */
+    inline void clear() noexcept {
+        auto message = pop_all();
+        while (message) {
+            auto next = message->next_inbound;
+            message->next_inbound = nullptr;
+            intrusive_ptr_release(message);
+            message = next;
+        }
+    }
+
+    /** \brief returns `true` if there are no pending messages */
+    inline bool empty() const noexcept { return !head.load(std::memory_order_acquire); }
+
+  private:
+    std::atomic<message_base_t *> head;
+};
+
+} // namespace rotor
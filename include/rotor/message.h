@@ -8,6 +8,10 @@
 
 #include "arc.hpp"
 #include "address.hpp"
+#include "extended_error.h"
+#include "message_pool.h"
+#include <chrono>
+#include <cstdint>
 #include <typeindex>
 #include <deque>
 
@@ -18,6 +22,25 @@
 
 namespace rotor {
 
+/** \brief message priority class, i.e. the lane of the locality messages queue
+ *
+ * Messages of higher priority are delivered before the lower ones, see
+ * {@link message_lanes_t}. The order of messages of the same priority
+ * is preserved.
+ *
+ */
+enum class message_priority_t : std::uint8_t {
+    /** \brief lifecycle and other control messages */
+    high = 0,
+    /** \brief the default priority */
+    normal,
+    /** \brief bulk data */
+    low,
+};
+
+/** \brief the amount of message priority classes */
+static constexpr std::size_t message_priorities = 3;
+
 /** \struct message_base_t
  *  \brief Base class for `rotor` message.
  *
@@ -27,7 +50,13 @@ namespace rotor {
  * The actual message payload meant to be provided by derived classes
  *
  */
-struct message_base_t : public arc_base_t<message_base_t> {
+struct message_base_t : public message_arc_base_t<message_base_t> {
+    /** \brief the clock of message deadlines */
+    using deadline_clock_t = std::chrono::steady_clock;
+
+    /** \brief message deadline (time point) */
+    using deadline_t = deadline_clock_t::time_point;
+
     virtual ~message_base_t() = default;
 
     /**
@@ -42,15 +71,147 @@ struct message_base_t : public arc_base_t<message_base_t> {
     /** \brief message destination address */
     address_ptr_t address;
 
+    /** \brief intrusive link, used by the inbound queue of a locality */
+    message_base_t *next_inbound;
+
+    /** \brief the priority class, it can be changed before the message is sent */
+    message_priority_t priority;
+
+    /** \brief whether a newer message with the same (address, type, key) replaces this one
+     * while it is not delivered yet, see {@link message_lanes_t} */
+    bool conflatable;
+
+    /** \brief the additional (to address and type) conflation key */
+    std::uint64_t conflation_key;
+
+    /** \brief the message is dropped, if it is not delivered before the deadline;
+     * the default (zero) time point means no deadline */
+    deadline_t deadline;
+
     /** \brief constructor which takes destination address */
-    inline message_base_t(const void *type_index_, const address_ptr_t &addr)
-        : type_index(type_index_), address{addr} {}
+    inline message_base_t(const void *type_index_, const address_ptr_t &addr,
+                          message_priority_t priority_ = message_priority_t::normal, bool conflatable_ = false)
+        : type_index(type_index_), address{addr}, next_inbound{nullptr}, priority{priority_},
+          conflatable{conflatable_}, conflation_key{0}, deadline{} {}
+
+    /** \brief returns `true` if the message has deadline */
+    inline bool has_deadline() const noexcept { return deadline != deadline_t{}; }
+
+    /** \brief sets the deadline as the time-to-live from now */
+    inline void expires_after(const deadline_clock_t::duration &ttl) noexcept {
+        deadline = deadline_clock_t::now() + ttl;
+    }
+
+    /** \brief returns the message, which notifies the sender that the message has been dropped
+     * because of its deadline (e.g. the error response to the request), or `nullptr` */
+    virtual intrusive_ptr_t<message_base_t> expire(const extended_error_ptr_t &reason) noexcept;
+
+#if defined(ROTOR_REFCOUNT_HYBRID)
+    /** \brief switches the message (and the messages it refers to) to the atomic
+     * reference counting; it should be invoked before the message is handed to
+     * other locality */
+    virtual void share() noexcept { set_shared(); }
+#else
+    /** \brief no-op, as messages reference counting mode is defined at build time */
+    inline void share() noexcept {}
+#endif
+
+    /** \brief allocates message from the pool of the current locality (if any) */
+    inline static void *operator new(std::size_t size) {
+        return message_pool_t::allocate(message_support::current_pool(), size);
+    }
+
+    /** \brief allocates message from the specified pool (`nullptr` means heap) */
+    inline static void *operator new(std::size_t size, message_pool_t *pool) {
+        return message_pool_t::allocate(pool, size);
+    }
+
+    /** \brief returns message memory to the owning pool or to the heap */
+    inline static void operator delete(void *ptr) noexcept { message_pool_t::deallocate(ptr); }
+
+    /** \brief returns message memory, if message construction fails */
+    inline static void operator delete(void *ptr, message_pool_t *) noexcept { message_pool_t::deallocate(ptr); }
 };
 
 namespace message_support {
+
+/** \struct registered_type_t
+ *  \brief runtime information about message type
+ *
+ * The `message_type` pointer of each message type points to the
+ * structure, i.e. the pointer uniquely identifies the message type
+ * across shared libraries.
+ *
+ */
+struct registered_type_t {
+    /** \brief mangled type name (`typeid(T).name()`) */
+    const char *name;
+
+    /** \brief dense (zero-based, sequential) message type id */
+    std::uint32_t id;
+};
+
+/** \brief registers message type and returns unique per-type pointer to `registered_type_t` */
 ROTOR_API const void *register_type(const std::type_index &type_index) noexcept;
+
+/** \brief returns dense id of the message type */
+inline std::uint32_t type_id(const void *message_type) noexcept {
+    return static_cast<const registered_type_t *>(message_type)->id;
+}
+
+/** \brief returns mangled name of the message type */
+inline const char *type_name(const void *message_type) noexcept {
+    return static_cast<const registered_type_t *>(message_type)->name;
+}
+
+/** \brief shares the messages, referred by the payload, if it defines `share_messages()` method */
+template <typename T> auto share_payload(T &payload, int) noexcept -> decltype(payload.share_messages(), void()) {
+    payload.share_messages();
+}
+
+/** \brief no-op for the payloads, which do not refer other messages */
+template <typename T> void share_payload(T &, long) noexcept {}
+
+/** \brief returns the priority, declared by the payload as `static constexpr message_priority_t priority` */
+template <typename T> constexpr auto payload_priority(int) noexcept -> decltype(T::priority, message_priority_t()) {
+    return T::priority;
+}
+
+/** \brief returns the default priority for the payloads, which do not declare it */
+template <typename T> constexpr message_priority_t payload_priority(long) noexcept {
+    return message_priority_t::normal;
+}
+
+/** \brief returns `true` if the payload declares `static constexpr bool conflate = true` */
+template <typename T> constexpr auto payload_conflate(int) noexcept -> decltype(T::conflate, bool()) {
+    return T::conflate;
+}
+
+/** \brief the messages are not conflated by default */
+template <typename T> constexpr bool payload_conflate(long) noexcept { return false; }
+
+/** \brief returns the conflation key, if the payload defines `conflation_key()` method */
+template <typename T>
+auto payload_conflation_key(const T &payload, int) noexcept -> decltype(std::uint64_t(payload.conflation_key())) {
+    return payload.conflation_key();
 }
 
+/** \brief the conflation is done by (address, type) only, if there is no payload key */
+template <typename T> std::uint64_t payload_conflation_key(const T &, long) noexcept { return 0; }
+
+/** \struct expiry_t
+ *  \brief produces the notification of the expired message with the payload of type `T`
+ *
+ * There is no notification by default; the specialization for requests produces
+ * the timeout error response.
+ *
+ */
+template <typename T, typename = void> struct expiry_t {
+    /** \brief whether there is notification for the payload type */
+    static constexpr bool enabled = false;
+};
+} // namespace message_support
+
 /** \struct message_t
  *  \brief the generic message meant to hold user-specific payload
  *  \tparam T payload type
@@ -63,7 +224,29 @@ template <typename T> struct message_t : public message_base_t {
     /** \brief forwards `args` for payload construction */
     template <typename... Args>
     message_t(const address_ptr_t &addr, Args &&...args)
-        : message_base_t{message_type, addr}, payload{std::forward<Args>(args)...} {}
+        : message_base_t{message_type, addr, message_support::payload_priority<T>(0),
+                         message_support::payload_conflate<T>(0)},
+          payload{std::forward<Args>(args)...} {
+        if constexpr (message_support::payload_conflate<T>(0)) {
+            conflation_key = message_support::payload_conflation_key(payload, 0);
+        }
+    }
+
+#if defined(ROTOR_REFCOUNT_HYBRID)
+    void share() noexcept override {
+        if (set_shared()) {
+            message_support::share_payload(payload, 0);
+        }
+    }
+#endif
+
+    intrusive_ptr_t<message_base_t> expire(const extended_error_ptr_t &reason) noexcept override {
+        if constexpr (message_support::expiry_t<T>::enabled) {
+            return message_support::expiry_t<T>::expire(*this, reason);
+        } else {
+            return message_base_t::expire(reason);
+        }
+    }
 
     /** \brief user-defined payload */
     T payload;
@@ -77,6 +260,8 @@ template <typename T> const void *message_t<T>::message_type = message_support::
 /** \brief intrusive pointer for message */
 using message_ptr_t = intrusive_ptr_t<message_base_t>;
 
+inline message_ptr_t message_base_t::expire(const extended_error_ptr_t &) noexcept { return {}; }
+
 /** \brief structure to hold messages (intrusive pointers) */
 using messages_queue_t = std::deque<message_ptr_t>;
 
@@ -85,6 +270,12 @@ template <typename M, typename... Args> auto make_message(const address_ptr_t &a
     return message_ptr_t{new message_t<M>(addr, std::forward<Args>(args)...)};
 }
 
+/** \brief constructs message by constructing it's payload in the memory of the specified pool */
+template <typename M, typename... Args>
+auto make_message(message_pool_t *pool, const address_ptr_t &addr, Args &&...args) -> message_ptr_t {
+    return message_ptr_t{new (pool) message_t<M>(addr, std::forward<Args>(args)...)};
+}
+
 } // namespace rotor
 
 #if defined(_MSC_VER)
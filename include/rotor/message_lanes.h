@@ -0,0 +1,255 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "message.h"
+#include <array>
+#include <functional>
+#include <unordered_map>
+
+namespace rotor {
+
+/** \struct conflation_stats_t
+ *
+ * \brief statistics of conflatable messages of a locality
+ */
+struct conflation_stats_t {
+    /** \brief total amount of conflatable messages put into the queue */
+    std::size_t messages = 0;
+
+    /** \brief amount of not yet delivered messages, replaced by newer ones */
+    std::size_t conflated = 0;
+};
+
+/** \struct message_lanes_t
+ *  \brief the locality messages queue with a FIFO lane per message priority
+ *
+ * The messages are appended to the lane of their priority
+ * (`message_base_t::priority`) and are taken from the highest non-empty
+ * lane first. To guarantee progress of the lower lanes, a non-empty lane,
+ * which has been passed over `max_skips` times in a row, is served next
+ * regardless of the higher lanes.
+ *
+ * The order of messages of the same priority is preserved.
+ *
+ * A conflatable message (`message_base_t::conflatable`) replaces the not yet
+ * delivered message with the same destination address, type and conflation key,
+ * i.e. the newest value is delivered at the place of the oldest one. Hence, a slow
+ * consumer does not fall behind on the messages, where only the latest matters.
+ *
+ */
+struct message_lanes_t {
+    /** \brief how many times in a row a non-empty lane can be passed over in favor of higher lanes */
+    static constexpr std::uint32_t max_skips = 16;
+
+    /** \brief returns `true` if there are no messages in all lanes */
+    inline bool empty() const noexcept { return total == 0; }
+
+    /** \brief returns the total amount of messages in all lanes */
+    inline std::size_t size() const noexcept { return total; }
+
+    /** \brief returns the lane of the priority */
+    inline const messages_queue_t &lane(message_priority_t priority) const noexcept {
+        return lanes[static_cast<std::size_t>(priority)];
+    }
+
+    /** \brief appends the message to the end of its lane (or conflates it) */
+    inline void push_back(message_ptr_t message) noexcept {
+        if (message->conflatable) {
+            auto slot = conflate(message);
+            if (!slot) {
+                return;
+            }
+            last_lane = static_cast<std::size_t>(message->priority);
+            *slot = &lanes[last_lane].emplace_back(std::move(message));
+        } else {
+            last_lane = static_cast<std::size_t>(message->priority);
+            lanes[last_lane].emplace_back(std::move(message));
+        }
+        ++total;
+    }
+
+    /** \brief constructs message pointer from the arguments and appends it to the end of its lane */
+    template <typename... Args> inline void emplace_back(Args &&...args) noexcept {
+        push_back(message_ptr_t(std::forward<Args>(args)...));
+    }
+
+    /** \brief puts the message to the beginning of its lane (or conflates it) */
+    inline void push_front(message_ptr_t message) noexcept {
+        auto index = static_cast<std::size_t>(message->priority);
+        if (message->conflatable) {
+            auto slot = conflate(message);
+            if (!slot) {
+                return;
+            }
+            *slot = &lanes[index].emplace_front(std::move(message));
+        } else {
+            lanes[index].emplace_front(std::move(message));
+        }
+        ++total;
+    }
+
+    /** \brief constructs message pointer from the arguments and puts it to the beginning of its lane */
+    template <typename... Args> inline void emplace_front(Args &&...args) noexcept {
+        push_front(message_ptr_t(std::forward<Args>(args)...));
+    }
+
+    /** \brief returns the next message to be processed (the queue must not be empty) */
+    inline const message_ptr_t &front() const noexcept { return lanes[select()].front(); }
+
+    /** \brief removes the next message to be processed (the queue must not be empty) */
+    inline void pop_front() noexcept {
+        auto index = select();
+        if (!conflation_slots.empty()) {
+            forget(*lanes[index].front());
+        }
+        pop_lane(index);
+    }
+
+    /** \brief removes and returns the next message to be processed (the queue must not be empty) */
+    inline message_ptr_t pop() noexcept {
+        auto index = select();
+        auto message = std::move(lanes[index].front());
+        if (!conflation_slots.empty()) {
+            forget(*message);
+        }
+        pop_lane(index);
+        return message;
+    }
+
+    /** \brief returns the last appended message (it must be still in the queue and not conflated) */
+    inline const message_ptr_t &back() const noexcept { return lanes[last_lane].back(); }
+
+    /** \brief removes and returns the last appended message (it must be still in the queue and not conflated) */
+    inline message_ptr_t pop_back() noexcept {
+        auto &lane = lanes[last_lane];
+        auto message = std::move(lane.back());
+        if (!conflation_slots.empty()) {
+            forget(*message);
+        }
+        lane.pop_back();
+        --total;
+        return message;
+    }
+
+    /** \brief removes all messages */
+    inline void clear() noexcept {
+        for (auto &lane : lanes) {
+            lane.clear();
+        }
+        conflation_slots.clear();
+        skips = {};
+        total = 0;
+    }
+
+    /** \brief returns conflation statistics */
+    inline const conflation_stats_t &get_conflation_stats() const noexcept { return conflation_stats; }
+
+  private:
+    /** \brief returns the lane index of the next message */
+    inline std::size_t select() const noexcept {
+        std::size_t first = 0;
+        while (lanes[first].empty()) {
+            ++first;
+        }
+        if (lanes[first].size() != total) {
+            for (auto i = first + 1; i < message_priorities; ++i) {
+                if (skips[i] >= max_skips && !lanes[i].empty()) {
+                    return i;
+                }
+            }
+        }
+        return first;
+    }
+
+    /** \struct conflation_key_t
+     *  \brief the identity of conflatable messages
+     */
+    struct conflation_key_t {
+        /** \brief destination address */
+        const address_t *address;
+
+        /** \brief message type */
+        const void *type;
+
+        /** \brief user-defined key */
+        std::uint64_t key;
+
+        /** \brief keys are equal if all their members are equal */
+        inline bool operator==(const conflation_key_t &other) const noexcept {
+            return address == other.address && type == other.type && key == other.key;
+        }
+    };
+
+    /** \brief hash of conflation key */
+    struct conflation_key_hash_t {
+        /** \brief combines hashes of the key members */
+        inline std::size_t operator()(const conflation_key_t &k) const noexcept {
+            auto h = std::hash<const void *>()(k.address);
+            h ^= std::hash<const void *>()(k.type) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<std::uint64_t>()(k.key) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    /** \brief the places of not delivered conflatable messages (type) */
+    using conflation_slots_t = std::unordered_map<conflation_key_t, message_ptr_t *, conflation_key_hash_t>;
+
+    /** \brief returns conflation key of the message */
+    static inline conflation_key_t key_of(const message_base_t &message) noexcept {
+        return conflation_key_t{message.address.get(), message.type_index, message.conflation_key};
+    }
+
+    /** \brief replaces pending message with the same key and returns `nullptr`, or returns
+     * the place for the slot of the message, which has to be enqueued */
+    inline message_ptr_t **conflate(message_ptr_t &message) noexcept {
+        ++conflation_stats.messages;
+        auto [it, inserted] = conflation_slots.try_emplace(key_of(*message), nullptr);
+        if (inserted) {
+            return &it->second;
+        }
+        *it->second = std::move(message);
+        ++conflation_stats.conflated;
+        return nullptr;
+    }
+
+    /** \brief forgets the slot of conflatable message, which is going to be removed
+     *
+     * The messages are never detached from their slots in place (`front()` and
+     * `back()` are read-only), so the slot is found by the message key.
+     */
+    inline void forget(const message_base_t &message) noexcept {
+        if (message.conflatable) {
+            conflation_slots.erase(key_of(message));
+        }
+    }
+
+    /** \brief removes the front message of the lane and accounts the lower lanes as passed over */
+    inline void pop_lane(std::size_t index) noexcept {
+        auto &lane = lanes[index];
+        auto single = lane.size() == total;
+        lane.pop_front();
+        --total;
+        skips[index] = 0;
+        if (!single) {
+            for (auto i = index + 1; i < message_priorities; ++i) {
+                if (!lanes[i].empty()) {
+                    ++skips[i];
+                }
+            }
+        }
+    }
+
+    std::array<messages_queue_t, message_priorities> lanes;
+    std::array<std::uint32_t, message_priorities> skips = {};
+    std::size_t total = 0;
+    std::size_t last_lane = static_cast<std::size_t>(message_priority_t::normal);
+    conflation_slots_t conflation_slots;
+    conflation_stats_t conflation_stats;
+};
+
+} // namespace rotor
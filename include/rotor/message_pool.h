@@ -0,0 +1,128 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/export.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace rotor {
+
+/** \struct message_pool_t
+ *  \brief size-class pool of memory blocks for messages of a locality
+ *
+ * The pool is owned by a locality leader (root supervisor of a locality) and
+ * caches up to `capacity` freed blocks per size class. Blocks are taken from
+ * and returned to the per-class free lists without any synchronization, when
+ * it is done in the context of the owning locality, i.e. when the pool is
+ * the current one (see `message_support::pool_guard_t`).
+ *
+ * When a message is released on a foreign thread (or outside of locality
+ * context), its block is pushed into the lock-free "returned" stack, which is
+ * lazily reclaimed by the owning locality upon the next free list miss.
+ *
+ * Every block (pooled or not) is prepended with a small header, which
+ * records the owning pool, so a message can be released anywhere.
+ *
+ * The pool outlives its owner, if there are still alive messages allocated
+ * from it: the last released message destroys the closed pool.
+ *
+ */
+struct ROTOR_API message_pool_t {
+    /** \brief amount of size classes */
+    static constexpr std::size_t size_classes = 5;
+
+    /** \brief the smallest block size; each next size class doubles it */
+    static constexpr std::size_t min_block_size = 64;
+
+    /** \brief constructs pool, which caches at most `capacity` blocks per size class */
+    message_pool_t(std::size_t capacity) noexcept;
+    message_pool_t(const message_pool_t &) = delete;
+    message_pool_t(message_pool_t &&) = delete;
+
+    /** \brief allocates memory for a message of the `size` bytes
+     *
+     * If `pool` is `nullptr` or the size exceeds the largest size class,
+     * the memory is allocated on heap.
+     *
+     */
+    static void *allocate(message_pool_t *pool, std::size_t size);
+
+    /** \brief releases memory, previously obtained via `allocate` */
+    static void deallocate(void *ptr) noexcept;
+
+    /** \brief releases cached blocks and destroys the pool as soon as
+     * the last message allocated from it is released */
+    void close() noexcept;
+
+    /** \brief amount of allocations served from the free lists */
+    inline std::size_t hits() const noexcept { return hits_count; }
+
+    /** \brief amount of allocations served from the heap */
+    inline std::size_t misses() const noexcept { return misses_count; }
+
+  private:
+    struct block_t;
+
+    ~message_pool_t();
+
+    void *allocate_block(std::size_t size);
+    void release(block_t *block) noexcept;
+    void recycle(block_t *block) noexcept;
+    void reclaim() noexcept;
+
+    block_t *free_lists[size_classes];
+    std::size_t free_counts[size_classes];
+    std::size_t capacity;
+    std::size_t live = 0;
+    std::size_t hits_count = 0;
+    std::size_t misses_count = 0;
+    std::atomic<block_t *> returned;
+    std::atomic<std::ptrdiff_t> orphans;
+};
+
+/** \brief closes the message pool upon `std::unique_ptr` destruction */
+struct message_pool_deleter_t {
+    /** \brief closes the message pool */
+    inline void operator()(message_pool_t *pool) const noexcept { pool->close(); }
+};
+
+/** \brief owning pointer to message pool */
+using message_pool_ptr_t = std::unique_ptr<message_pool_t, message_pool_deleter_t>;
+
+namespace message_support {
+
+/** \brief returns (thread-local) pool of the currently executing locality (if any) */
+ROTOR_API message_pool_t *&current_pool() noexcept;
+
+/** \struct pool_guard_t
+ *  \brief makes the pool current for the lifetime of the guard
+ */
+struct pool_guard_t {
+    /** \brief makes the pool current, remembering the previous one */
+    inline pool_guard_t(message_pool_t *pool) noexcept : previous{current_pool()} { current_pool() = pool; }
+
+    /** \brief restores the previously current pool */
+    inline ~pool_guard_t() { current_pool() = previous; }
+
+  private:
+    message_pool_t *previous;
+};
+
+} // namespace message_support
+
+} // namespace rotor
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
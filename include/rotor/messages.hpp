@@ -13,6 +13,7 @@
 #include "subscription_point.h"
 #include "forward.hpp"
 #include "extended_error.h"
+#include <boost/container/small_vector.hpp>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -119,7 +120,7 @@ struct shutdown_request_t {
 };
 
 /** \struct handler_call_t
- *  \brief Message with this payload is forwarded to the handler's supervisor for
+ *  \brief Message with this payload is forwarded to the handlers' supervisor for
  * the delivery of the original message.
  *
  * An `address` in `rotor` is always generated by a supervisor. All messages to the
@@ -129,14 +130,34 @@ struct shutdown_request_t {
  * be to different event loop), then the delivery of the message is forwarded to
  * that supervisor.
  *
+ * All external handlers of the same supervisor are forwarded within a single
+ * message, i.e. there is one call per foreign supervisor, not per handler.
+ *
  */
 struct handler_call_t {
+    /** \brief handlers of the same supervisor; the single handler case does not allocate */
+    using handlers_t = boost::container::small_vector<handler_ptr_t, 1>;
+
+    /** \brief constructs the call of the single handler */
+    handler_call_t(message_ptr_t orig_message_, handler_ptr_t handler) noexcept
+        : orig_message{std::move(orig_message_)} {
+        handlers.emplace_back(std::move(handler));
+    }
+
+    /** \brief constructs the call of the group of handlers, i.e. from the range of raw handler pointers */
+    template <typename Iterator>
+    handler_call_t(message_ptr_t orig_message_, Iterator first, Iterator last) noexcept
+        : orig_message{std::move(orig_message_)}, handlers(first, last) {}
+
     /** \brief The original message (intrusive pointer) sent to an address */
     message_ptr_t orig_message;
 
-    /** \brief The handler (intrusive pointer) on some external supervisor,
+    /** \brief The handlers (intrusive pointers) on some external supervisor,
      * which can process the original message */
-    handler_ptr_t handler;
+    handlers_t handlers;
+
+    /** \brief shares the original message along with the call */
+    inline void share_messages() noexcept { orig_message->share(); }
 };
 
 /** \struct external_subscription_t
@@ -102,7 +102,7 @@ struct ROTOR_API child_manager_plugin_t : public plugin_base_t {
     using actors_map_t = std::unordered_map<address_ptr_t, detail::child_info_ptr_t>;
     using spawning_map_t = std::unordered_map<request_id_t, detail::child_info_ptr_t>;
 
-    bool has_initializing() const noexcept;
+    bool has_initializing() noexcept;
     void init_continue() noexcept;
     void request_shutdown(const extended_error_ptr_t &ec) noexcept;
     void cancel_init(const actor_base_t *child) noexcept;
@@ -110,6 +110,7 @@ struct ROTOR_API child_manager_plugin_t : public plugin_base_t {
     void on_spawn_timer(request_id_t timer_id, bool cancelled) noexcept;
 
     size_t active_actors() noexcept;
+    void track(const detail::child_info_t &info, std::ptrdiff_t delta) noexcept;
 
     /** \brief type for keeping list of initializing actors (during supervisor initialization) */
     using initializing_actors_t = std::unordered_set<address_ptr_t>;
@@ -117,6 +118,18 @@ struct ROTOR_API child_manager_plugin_t : public plugin_base_t {
     /** \brief local address to local actor (intrusive pointer) mapping */
     actors_map_t actors_map;
     spawning_map_t spawning_map;
+
+    /** \brief children, which might still be initializing (stale entries are purged lazily) */
+    initializing_actors_t initializing_actors;
+
+    /** \brief amount of children with actor instance or with pending spawn timer */
+    size_t live_children = 0;
+
+    /** \brief amount of active spawners without actor instance and without pending spawn timer */
+    size_t idle_spawners = 0;
+
+    /** \brief whether there might be children (or spawn timers) not requested to shut down yet */
+    bool shutdown_unrequested = true;
 };
 
 } // namespace rotor::plugin
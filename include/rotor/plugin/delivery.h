@@ -7,7 +7,9 @@
 //
 
 #include "plugin_base.h"
+#include "rotor/message_lanes.h"
 #include <string>
+#include <vector>
 
 #if !defined(NDEBUG) && !defined(ROTOR_DEBUG_DELIVERY)
 #define ROTOR_DO_DELIVERY_DEBUG 1
@@ -15,6 +17,8 @@
 
 namespace rotor::plugin {
 
+struct delivery_plugin_base_t;
+
 /** \struct local_delivery_t
  *
  * \brief basic local message delivery implementation
@@ -27,11 +31,12 @@ struct ROTOR_API local_delivery_t {
      *
      * - If the handler is local (i.e. it's actor belongs to the same supervisor),
      * - Otherwise the message is forwarded for delivery for the foreign supervisor,
-     * which owns the handler.
+     * which owns the handler. The forwarded message is appended to the hand-off batch of
+     * the foreign supervisor, to keep the order with the messages sent to it directly.
      *
      */
-
-    static void delivery(message_ptr_t &message, const subscription_t::joint_handlers_t &local_recipients) noexcept;
+    static void delivery(delivery_plugin_base_t &plugin, message_ptr_t &message,
+                         const subscription_t::joint_handlers_t &local_recipients) noexcept;
 };
 
 /** \struct inspected_local_delivery_t
@@ -43,7 +48,8 @@ struct ROTOR_API inspected_local_delivery_t {
     static std::string identify(const message_base_t *message, int32_t threshold) noexcept;
 
     /** \brief delivers the message to the recipients, possibly dumping it to console */
-    static void delivery(message_ptr_t &message, const subscription_t::joint_handlers_t &local_recipients) noexcept;
+    static void delivery(delivery_plugin_base_t &plugin, message_ptr_t &message,
+                         const subscription_t::joint_handlers_t &local_recipients) noexcept;
 
     /** \brief dumps discarded message */
     static void discard(message_ptr_t &message) noexcept;
@@ -55,6 +61,35 @@ using default_local_delivery_t = local_delivery_t;
 using default_local_delivery_t = inspected_local_delivery_t;
 #endif
 
+/** \struct handoff_stats_t
+ *
+ * \brief statistics of messages handed off to the supervisors of other localities
+ */
+struct handoff_stats_t {
+    /** \brief amount of wake-up notifications, i.e. handed off batches */
+    std::size_t wakeups = 0;
+
+    /** \brief total amount of handed off messages */
+    std::size_t messages = 0;
+
+    /** \brief average amount of messages per wake-up notification */
+    inline double messages_per_wakeup() const noexcept {
+        return wakeups ? static_cast<double>(messages) / static_cast<double>(wakeups) : 0.0;
+    }
+};
+
+/** \struct expiry_stats_t
+ *
+ * \brief statistics of messages dropped because of their deadlines
+ */
+struct expiry_stats_t {
+    /** \brief total amount of dropped messages */
+    std::size_t messages = 0;
+
+    /** \brief amount of dropped requests, i.e. answered with `request_timeout` error */
+    std::size_t requests = 0;
+};
+
 /** \struct delivery_plugin_base_t
  *
  * \brief base implementation for messages delivery plugin
@@ -66,15 +101,78 @@ struct ROTOR_API delivery_plugin_base_t : public plugin_base_t {
     virtual size_t process() noexcept = 0;
     void activate(actor_base_t *actor) noexcept override;
 
+    /** \brief returns statistics of messages handed off to other localities */
+    inline const handoff_stats_t &get_handoff_stats() const noexcept { return handoff_stats; }
+
+    /** \brief returns statistics of messages dropped because of their deadlines */
+    inline const expiry_stats_t &get_expiry_stats() const noexcept { return expiry_stats; }
+
   protected:
+    /** \brief returns `true` if the message deadline has passed, i.e. it should not be dispatched */
+    inline bool expired(message_base_t &message) noexcept { return message.has_deadline() && expire(message); }
+
+    /** \brief drops the message if its deadline has passed (and notifies the sender, if possible) */
+    bool expire(message_base_t &message) noexcept;
+
+    /** \struct handoff_batch_t
+     *  \brief messages pending for the foreign locality, linked via `next_inbound` in FIFO order
+     */
+    struct handoff_batch_t {
+        /** \brief destination supervisor (the locality leader) */
+        supervisor_t *supervisor;
+
+        /** \brief the first message in the batch */
+        message_base_t *first;
+
+        /** \brief the last message in the batch */
+        message_base_t *last;
+
+        /** \brief amount of messages in the batch */
+        std::size_t count;
+    };
+
+    /** \brief the max amount of messages, processed while there are pending hand-off batches
+     *
+     * The batches are flushed, when the queue runs dry or after that amount of processed
+     * messages, i.e. handing off is not postponed infinitely under the local load.
+     */
+    static constexpr std::size_t handoff_window = 64;
+
+    /** \brief appends message to the batch of the destination (foreign) supervisor */
+    void handoff(message_ptr_t &message) noexcept;
+
+    /** \brief hands off all pending batches, i.e. one `enqueue_batch` per destination supervisor */
+    void flush_handoffs() noexcept;
+
+    /** \brief accounts processed message and flushes pending batches, when `handoff_window` is reached */
+    inline void handoff_step() noexcept {
+        if (!handoff_batches.empty() && ++handoff_window_count >= handoff_window) {
+            flush_handoffs();
+        }
+    }
+
+    /** \brief messages batches per foreign supervisor, collected during `process()` */
+    std::vector<handoff_batch_t> handoff_batches;
+
+    /** \brief amount of messages, processed since the oldest pending hand-off */
+    std::size_t handoff_window_count = 0;
+
+    /** \brief messages hand-off statistics */
+    handoff_stats_t handoff_stats;
+
+    /** \brief expired messages statistics */
+    expiry_stats_t expiry_stats;
+
     /** \brief non-owning raw pointer of supervisor's messages queue */
-    messages_queue_t *queue = nullptr;
+    message_lanes_t *queue = nullptr;
 
     /** \brief non-owning raw pointer to supervisor's main address */
     address_t *address = nullptr;
 
     /** \brief non-owning raw pointer to supervisor's subscriptions map */
     subscription_t *subscription_map;
+
+    friend struct local_delivery_t;
 };
 
 /** \brief templated message delivery plugin, to allow local message delivery be customized */
@@ -10,7 +10,10 @@
 #include "message.h"
 #include "extended_error.h"
 #include "forward.hpp"
+#include "detail/timer_wheel.h"
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 namespace rotor {
 
@@ -84,6 +87,9 @@ template <typename T, typename = void> struct wrapped_request_t : request_base_t
     /** \brief alias for original (unwrapped) response payload type */
     using response_t = typename T::response_t;
 
+    /** \brief the request message priority is inherited from the original payload */
+    static constexpr message_priority_t priority = message_support::payload_priority<T>(0);
+
     /** \brief constructs wrapper for user-supplied payload from request-id and
      * and destination reply address */
     template <typename... Args>
@@ -120,6 +126,9 @@ struct wrapped_request_t<T, std::enable_if_t<std::is_base_of_v<arc_base_t<T>, T>
     /** \brief alias for original (unwrapped) response payload type */
     using response_t = typename T::response_t;
 
+    /** \brief the request message priority is inherited from the original payload */
+    static constexpr message_priority_t priority = message_support::payload_priority<T>(0);
+
     /** \brief makes an intrusive pointer for already constructed user-supplied payload
      *
      * The different `request-id` and `reply_to` address arguments are supplied
@@ -139,6 +148,24 @@ struct wrapped_request_t<T, std::enable_if_t<std::is_base_of_v<arc_base_t<T>, T>
     request_t request_payload;
 };
 
+template <typename R> struct request_traits_t;
+
+namespace message_support {
+
+/** \brief the expired request is answered with error response to the requester */
+template <typename T, typename E> struct expiry_t<wrapped_request_t<T, E>> {
+    /** \brief whether there is notification for the payload type */
+    static constexpr bool enabled = true;
+
+    /** \brief makes error response to the expired request */
+    static message_ptr_t expire(message_t<wrapped_request_t<T, E>> &message,
+                                const extended_error_ptr_t &reason) noexcept {
+        return request_traits_t<T>::make_error_response(message.payload.reply_to, message, reason);
+    }
+};
+
+} // namespace message_support
+
 /** \struct response_helper_t
  * \brief generic helper, which helps to construct user-defined response payload
  */
@@ -290,12 +317,116 @@ template <typename Request> struct wrapped_response_t {
 
     /** \brief returns request id of the original request */
     inline request_id_t request_id() const noexcept { return req->payload.id; }
+
+    /** \brief shares the original request along with the response */
+    inline void share_messages() noexcept {
+        if (req) {
+            req->share();
+        }
+    }
 };
 
+/** \brief how the responses to the scattered requests are gathered */
+enum class gather_mode_t : std::uint8_t {
+    /** \brief all the responses are gathered (`request_all`) */
+    all,
+    /** \brief the first successful response wins (`request_any`) */
+    any,
+};
+
+/** \struct gathered_response_t
+ * \brief the single aggregated response to the request, scattered to several addresses
+ *
+ * The scattered (sub)requests share the same request id, timeout and bookkeeping
+ * record of the supervisor. The aggregated response is delivered to the requester,
+ * when all the responses arrived (`gather_mode_t::all`), or when the first
+ * successful response arrived (`gather_mode_t::any`; the rest requests are cancelled),
+ * or upon timeout (the unanswered requests are cancelled).
+ *
+ * The destination addresses must be distinct, as the cancellation of the request is
+ * identified by the destination address and the shared request id.
+ *
+ */
+template <typename Request, gather_mode_t Mode> struct gathered_response_t {
+    /** \brief alias for original user-supplied request type */
+    using request_t = typename request_unwrapper_t<Request>::request_t;
+
+    /** \brief alias for intrusive pointer to message with wrapped request */
+    using req_message_ptr_t = typename wrapped_response_t<request_t>::req_message_ptr_t;
+
+    /** \brief alias for intrusive pointer to message with wrapped response */
+    using res_message_ptr_t = intrusive_ptr_t<message_t<wrapped_response_t<request_t>>>;
+
+    /** \brief the gathering mode */
+    static constexpr gather_mode_t mode = Mode;
+
+    /** \brief the request id, shared by all the scattered requests */
+    request_id_t id = 0;
+
+    /** \brief the aggregated error
+     *
+     * It is `request_timeout`, when not all the responses arrived in time (`all` mode),
+     * or when no successful response arrived in time (`any` mode). In the `any` mode, when
+     * all the responses are errors, it is the error of the last response.
+     *
+     */
+    extended_error_ptr_t ee;
+
+    /** \brief the scattered requests, in the order of destination addresses */
+    std::vector<req_message_ptr_t> requests;
+
+    /** \brief the arrived responses (possibly with errors), aligned with `requests`; `nullptr` if absent */
+    std::vector<res_message_ptr_t> responses;
+
+    /** \brief the first successful response (`any` mode only) */
+    res_message_ptr_t response;
+
+    /** \brief the amount of requests, which are not answered yet */
+    std::size_t pending = 0;
+
+    /** \brief returns request id of the scattered request */
+    inline request_id_t request_id() const noexcept { return id; }
+
+    /** \brief shares the requests and responses along with the aggregated response */
+    inline void share_messages() noexcept {
+        for (auto &req : requests) {
+            req->share();
+        }
+        for (auto &res : responses) {
+            if (res) {
+                res->share();
+            }
+        }
+        if (response) {
+            response->share();
+        }
+    }
+};
+
+struct request_curry_t;
+
+/** \brief free function type, which gathers response of the scattered request */
+typedef void(response_collector_t)(supervisor_t &sup, request_curry_t &curry, message_base_t &response) noexcept;
+
 /** \brief free function type, which produces error response to the original request */
 typedef message_ptr_t(error_producer_t)(const address_ptr_t &reply_to, message_base_t &msg,
                                         const extended_error_ptr_t &ec) noexcept;
 
+/** \struct response_sink_t
+ * \brief receives the response right from the supervisor (e.g. to resume a coroutine)
+ *
+ * The response is handed to the sink in the context of the locality, bypassing
+ * re-addressing it to the reply address and dispatching it again. The timeout
+ * error response is still delivered to the reply address.
+ *
+ */
+struct response_sink_t {
+    virtual ~response_sink_t() = default;
+
+    /** \brief invoked upon response arrival of the request (the request is already discarded) */
+    virtual void on_response(request_id_t request_id, message_base_t &response) noexcept = 0;
+};
+
 /** \struct request_curry_t
  * \brief the recorded context, which is needed to produce error response to the original request */
 struct request_curry_t {
@@ -310,6 +441,15 @@ struct request_curry_t {
 
     /** \brief actor, on which behalf the original request has been made */
     actor_base_t *source;
+
+    /** \brief the receiver of the successful response instead of the reply address (optional) */
+    response_sink_t *sink = nullptr;
+
+    /** \brief gathers the responses of the scattered request (`nullptr` for ordinary requests) */
+    response_collector_t *collector = nullptr;
+
+    /** \brief the node of the supervisor requests timeout wheel (if it is used) */
+    detail::wheel_hook_t timeout_hook = {};
 };
 
 /** \struct request_traits_t
@@ -360,6 +500,32 @@ template <typename R> struct request_traits_t {
         using message_t = rotor::message_t<cancel_payload_t>;
     };
 
+    /** \struct all_response
+     * \brief aggregated response types of `request_all` */
+    struct all_response {
+        /** \brief aggregated response payload */
+        using wrapped_t = gathered_response_t<request_t, gather_mode_t::all>;
+
+        /** \brief aggregated response message */
+        using message_t = rotor::message_t<wrapped_t>;
+
+        /** \brief intrusive pointer type for aggregated response message */
+        using message_ptr_t = intrusive_ptr_t<message_t>;
+    };
+
+    /** \struct any_response
+     * \brief aggregated response types of `request_any` */
+    struct any_response {
+        /** \brief aggregated response payload */
+        using wrapped_t = gathered_response_t<request_t, gather_mode_t::any>;
+
+        /** \brief aggregated response message */
+        using message_t = rotor::message_t<wrapped_t>;
+
+        /** \brief intrusive pointer type for aggregated response message */
+        using message_ptr_t = intrusive_ptr_t<message_t>;
+    };
+
     /** \brief helper free function to produce error reply to the original request */
     static message_ptr_t make_error_response(const address_ptr_t &reply_to, message_base_t &message,
                                              const extended_error_ptr_t &ee) noexcept {
@@ -382,6 +548,13 @@ template <typename T> struct [[nodiscard]] request_builder_t {
     request_builder_t(supervisor_t &sup_, actor_base_t &actor_, const address_ptr_t &destination_,
                       const address_ptr_t &reply_to_, Args &&...args);
 
+    /** \brief constructs request message, which response is routed via the response address
+     * of the actor, already known from the previous request (see `get_response_address`)
+     */
+    template <typename... Args>
+    request_builder_t(const address_ptr_t &response_address, supervisor_t &sup_, actor_base_t &actor_,
+                      const address_ptr_t &destination_, const address_ptr_t &reply_to_, Args &&...args);
+
     /** \brief actually dispatches requests and spawns timeout timer
      *
      * The request id of the dispatched request is returned
@@ -389,6 +562,21 @@ template <typename T> struct [[nodiscard]] request_builder_t {
      */
     request_id_t send(const pt::time_duration &send) noexcept;
 
+    /** \brief sets time-to-live of the request message
+     *
+     * If the request is not delivered in time, it is dropped, and the requester
+     * gets the `request_timeout` error response immediately (and only once).
+     *
+     */
+    request_builder_t &ttl(const pt::time_duration &ttl) noexcept;
+
+    /** \brief hands the response to the sink instead of delivering it to the reply address */
+    request_builder_t &sink(response_sink_t &sink) noexcept;
+
+    /** \brief returns the (imaginary) address, where the responses of the actor's requests are
+     * routed via the supervisor; it stays valid for the further requests after `send` */
+    const address_ptr_t &get_response_address() const noexcept { return imaginary_address; }
+
   private:
     using traits_t = request_traits_t<T>;
     using request_message_t = typename traits_t::request::message_t;
@@ -405,8 +593,61 @@ template <typename T> struct [[nodiscard]] request_builder_t {
     bool do_install_handler;
     request_message_ptr_t req;
     address_ptr_t imaginary_address;
+    response_sink_t *response_sink = nullptr;
+
+    static void install_handler(supervisor_t &sup, actor_base_t &actor,
+                                const address_ptr_t &imaginary_address) noexcept;
+    static address_ptr_t imaginary_address_of(supervisor_t &sup, actor_base_t &actor, bool &do_install) noexcept;
+
+    template <typename, gather_mode_t> friend struct gather_builder_t;
+};
 
-    void install_handler() noexcept;
+/** \struct gather_builder_t
+ * \brief builder of the request, which is scattered to several addresses
+ *
+ * All the requests are made from the same arguments and share single request
+ * id, timeout and bookkeeping record. The responses are gathered in the
+ * `gathered_response_t` message, which is delivered to the reply address.
+ * The destination addresses must be distinct.
+ *
+ */
+template <typename T, gather_mode_t Mode> struct [[nodiscard]] gather_builder_t {
+    /** \brief constructs request messages (one per destination) but still does not dispatch them */
+    template <typename... Args>
+    gather_builder_t(supervisor_t &sup_, actor_base_t &actor_, const std::vector<address_ptr_t> &destinations,
+                     const address_ptr_t &reply_to_, Args &&...args);
+
+    /** \brief dispatches the requests and spawns single timeout timer for them
+     *
+     * The request id (shared by all the requests) is returned
+     *
+     */
+    request_id_t send(const pt::time_duration &timeout) noexcept;
+
+    /** \brief sets time-to-live of each request message (see `request_builder_t::ttl`) */
+    gather_builder_t &ttl(const pt::time_duration &ttl) noexcept;
+
+  private:
+    using traits_t = request_traits_t<T>;
+    using request_message_t = typename traits_t::request::message_t;
+    using response_message_t = typename traits_t::response::message_t;
+    using cancel_payload_t = typename traits_t::cancel::cancel_payload_t;
+    using gathered_t = gathered_response_t<T, Mode>;
+    using gathered_message_t = message_t<gathered_t>;
+    using gathered_message_ptr_t = intrusive_ptr_t<gathered_message_t>;
+
+    static message_ptr_t make_error_response(const address_ptr_t &reply_to, message_base_t &message,
+                                             const extended_error_ptr_t &ee) noexcept;
+    static void collect(supervisor_t &sup, request_curry_t &curry, message_base_t &response) noexcept;
+    static void cancel_pending(gathered_t &payload) noexcept;
+    static bool unique(const std::vector<address_ptr_t> &destinations) noexcept;
+
+    supervisor_t &sup;
+    actor_base_t &actor;
+    const address_ptr_t &reply_to;
+    bool do_install_handler;
+    address_ptr_t imaginary_address;
+    gathered_message_ptr_t gathered;
 };
 
 } // namespace rotor
@@ -34,17 +34,41 @@ struct ROTOR_API subscription_t {
     /** \brief vector of handler pointers */
     using handlers_t = std::vector<handler_base_t *>;
 
+    /** \struct handler_entry_t
+     *  \brief devirtualized invocation point of the internal handler
+     */
+    struct handler_entry_t {
+        /** \brief delivers the message to the handler without virtual call and type check */
+        handler_thunk_t thunk;
+
+        /** \brief non-owning pointer to the handler */
+        handler_base_t *handler;
+    };
+
+    /** \brief contiguous array of handler invocation points */
+    using handler_entries_t = std::vector<handler_entry_t>;
+
     /** \struct joint_handlers_t
      *  \brief pair internal and external {@link handler_t}
      */
     struct joint_handlers_t {
-        /** \brief internal handlers, i.e. those which belong to actors of the supervisor */
-        handlers_t internal;
-        /** \brief external handlers, i.e. those which belong to actors of other supervisor */
+        /** \brief internal handlers, i.e. those which belong to actors of the supervisor
+         *
+         * The message type is already matched upon recipients lookup, so the handlers
+         * are invoked via thunks, i.e. without virtual call and message type check.
+         */
+        handler_entries_t internal;
+        /** \brief external handlers, i.e. those which belong to actors of other supervisor
+         *
+         * The handlers of the same supervisor are kept adjacent, so the message
+         * can be forwarded to each foreign supervisor at once.
+         */
         handlers_t external;
     };
 
     subscription_t() noexcept;
+    subscription_t(const subscription_t &) = delete;
+    ~subscription_t();
 
     /** \brief upgrades subscription_point_t into subscription_info smart pointer
      *
@@ -61,7 +85,12 @@ struct ROTOR_API subscription_t {
     /** \brief remove subscription_info from `internal_infos` and `mine_handlers` */
     void forget(const subscription_info_ptr_t &info) noexcept;
 
-    /** \brief returns list of all handlers for the message (internal and external) */
+    /** \brief returns list of all handlers for the message (internal and external)
+     *
+     * The handlers are looked up without hashing: via the dispatch table of the
+     * message address, where the handlers are indexed by dense message type id.
+     *
+     */
     const joint_handlers_t *get_recipients(const message_base_t &message) const noexcept;
 
     /** \brief generic non-public fields accessor */
@@ -85,11 +114,35 @@ struct ROTOR_API subscription_t {
     using addressed_handlers_t = boost::unordered_map<subscription_key_t, joint_handlers_t, subscription_key_hash_t>;
 
     using info_container_t = boost::unordered_map<address_ptr_t, std::vector<subscription_info_ptr_t>>;
+
+    void index(address_t &address, const void *message_type, const joint_handlers_t &handlers) noexcept;
+    void unindex(address_t &address, const void *message_type) noexcept;
+
     address_t *main_address;
     info_container_t internal_infos;
     addressed_handlers_t mine_handlers;
 };
 
+namespace detail {
+
+/** \struct dispatch_table_t
+ *  \brief per-address handlers, indexed by dense message type id
+ *
+ * The type ids are kept contiguously, so the lookup is a short linear scan,
+ * which depends on the amount of message types subscribed on the address only,
+ * not on the total amount of message types.
+ *
+ */
+struct dispatch_table_t {
+    /** \brief dense ids of subscribed message types */
+    std::vector<std::uint32_t> type_ids;
+
+    /** \brief handlers for the message types (parallel to `type_ids`) */
+    std::vector<const subscription_t::joint_handlers_t *> handlers;
+};
+
+} // namespace detail
+
 } // namespace rotor
 
 #if defined(_MSC_VER)
@@ -10,6 +10,7 @@
 #include "rotor/address.hpp"
 #include <vector>
 #include <list>
+#include <unordered_map>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -128,10 +129,94 @@ using subscription_info_ptr_t = intrusive_ptr_t<subscription_info_t>;
 
 /** \struct subscription_container_t
  *  \brief list of {@link subscription_info_ptr_t} with possibility to find via {@link subscription_point_t}
+ *
+ * The subscription infos are iterated in the insertion order, while lookup and
+ * removal are `O(1)`: the list is accompanied by the index on (handler, address)
+ * pair. If the same pair has been recorded several times, the most recently
+ * inserted one is found first.
+ *
  */
-struct ROTOR_API subscription_container_t : public std::list<subscription_info_ptr_t> {
+struct ROTOR_API subscription_container_t {
+    /** \brief underlying list of subscription infos */
+    using list_t = std::list<subscription_info_ptr_t>;
+
+    /** \brief iterator over subscription infos */
+    using iterator = list_t::iterator;
+
+    /** \brief const iterator over subscription infos */
+    using const_iterator = list_t::const_iterator;
+
+    /** \brief reverse iterator over subscription infos */
+    using reverse_iterator = list_t::reverse_iterator;
+
     /** \brief looks up for the subscription info pointer (returned as iterator) via the subscription point */
     iterator find(const subscription_point_t &point) noexcept;
+
+    /** \brief appends the subscription info to the end */
+    void emplace_back(const subscription_info_ptr_t &info) noexcept;
+
+    /** \brief removes the subscription info, returns the iterator following the removed one */
+    iterator erase(iterator it) noexcept;
+
+    /** \brief removes all subscription infos */
+    void clear() noexcept;
+
+    /** \brief whether there are no subscription infos */
+    inline bool empty() const noexcept { return items.empty(); }
+
+    /** \brief amount of subscription infos */
+    inline std::size_t size() const noexcept { return items.size(); }
+
+    /** \brief iterator to the first (oldest) subscription info */
+    inline iterator begin() noexcept { return items.begin(); }
+
+    /** \brief iterator past the last subscription info */
+    inline iterator end() noexcept { return items.end(); }
+
+    /** \brief const iterator to the first (oldest) subscription info */
+    inline const_iterator begin() const noexcept { return items.begin(); }
+
+    /** \brief const iterator past the last subscription info */
+    inline const_iterator end() const noexcept { return items.end(); }
+
+    /** \brief reverse iterator to the last (newest) subscription info */
+    inline reverse_iterator rbegin() noexcept { return items.rbegin(); }
+
+    /** \brief reverse iterator past the first subscription info */
+    inline reverse_iterator rend() noexcept { return items.rend(); }
+
+  private:
+    struct index_key_t {
+        const void *handler_type;
+        const actor_base_t *actor;
+        const address_t *address;
+
+        inline bool operator==(const index_key_t &other) const noexcept {
+            return handler_type == other.handler_type && actor == other.actor && address == other.address;
+        }
+    };
+
+    struct key_hash_t {
+        inline std::size_t operator()(const index_key_t &key) const noexcept {
+            auto h1 = reinterpret_cast<std::size_t>(key.handler_type);
+            auto h2 = reinterpret_cast<std::size_t>(key.actor);
+            auto h3 = reinterpret_cast<std::size_t>(key.address);
+            return h1 ^ (h2 << 1) ^ (h3 >> 3);
+        }
+    };
+
+    /* the most recently inserted subscription info with the key, and total amount of them */
+    struct slot_t {
+        iterator last;
+        std::size_t count;
+    };
+
+    using index_t = std::unordered_map<index_key_t, slot_t, key_hash_t>;
+
+    static index_key_t key_of(const subscription_point_t &point) noexcept;
+
+    list_t items;
+    index_t index;
 };
 
 } // namespace rotor
@@ -16,13 +16,18 @@
 #include "address_mapping.h"
 #include "error_code.h"
 #include "spawner.h"
-
+#include "inbound_queue.h"
+#include "message_lanes.h"
+#include "detail/timer_heap.h"
+#include "detail/timer_wheel.h"
+#include "detail/frame_pool.h"
+
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <unordered_map>
 #include <unordered_set>
 
-#include <boost/lockfree/queue.hpp>
-
 #if defined(_MSC_VER)
 #pragma warning(push)
 #pragma warning(disable : 4251)
@@ -129,7 +134,10 @@ struct ROTOR_API supervisor_t : public actor_base_t {
      * (i.e. to be processed externally).
      *
      */
-    inline size_t do_process() noexcept { return locality_leader->delivery->process(); }
+    inline size_t do_process() noexcept {
+        message_support::pool_guard_t guard(locality_leader->message_pool.get());
+        return locality_leader->delivery->process();
+    }
 
     /** \brief creates new {@link address_t} linked with the supervisor */
     virtual address_ptr_t make_address() noexcept;
@@ -175,13 +183,53 @@ struct ROTOR_API supervisor_t : public actor_base_t {
      */
     virtual void enqueue(message_ptr_t message) noexcept = 0;
 
+    /** \brief enqueues the batch of messages thread safe way and triggers processing once
+     *
+     * The messages are linked via `next_inbound` pointer in FIFO order, and the
+     * supervisor takes ownership of one reference of each message. The messages
+     * are already shared (see `message_base_t::share()`).
+     *
+     * The default implementation just enqueues messages one by one; the backends
+     * are expected to push the whole batch and notify the event loop only once.
+     *
+     */
+    virtual void enqueue_batch(message_base_t *first) noexcept;
+
     /** \brief puts a message into internal supervisor queue for further processing
      *
      * This is thread-unsafe method. The `enqueue` method should be used to put
      * a new message from external context in thread-safe way.
      *
      */
-    inline void put(message_ptr_t message) { locality_leader->queue.emplace_back(std::move(message)); }
+    inline void put(message_ptr_t message) { locality_leader->queue.push_back(std::move(message)); }
+
+    /** \brief marks the inbound queue draining as pending (thread-safe)
+     *
+     * Returns `true` only upon transition into the pending state, i.e. when the
+     * caller (backend `enqueue` implementation) should schedule inbound queue
+     * draining (post a callback, notify a condition variable etc.). Otherwise
+     * the draining is already scheduled, and it will pick the message up.
+     *
+     * Should be invoked on the locality leader *after* pushing message(s) into
+     * its inbound queue.
+     *
+     */
+    inline bool request_wakeup() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return !wakeup_pending.exchange(true, std::memory_order_acq_rel);
+    }
+
+    /** \brief clears the pending wake-up state
+     *
+     * Should be invoked on the locality leader by the scheduled draining routine
+     * (or before going to sleep) *before* draining the inbound queue; the
+     * messages pushed after that will request the wake-up again.
+     *
+     */
+    inline void clear_wakeup() noexcept {
+        wakeup_pending.store(false, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
 
     /** \brief templated version of `subscribe_actor` */
     template <typename Handler> void subscribe(actor_base_t &actor, Handler &&handler) {
@@ -241,21 +289,42 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     /** \brief returns registry actor address (if it was defined or registry actor was created) */
     inline const address_ptr_t &get_registry_address() const noexcept { return registry_address; }
 
+    /** \brief returns statistics of messages handed off to the other localities */
+    inline const plugin::handoff_stats_t &get_handoff_stats() const noexcept {
+        return locality_leader->delivery->get_handoff_stats();
+    }
+
+    /** \brief returns statistics of messages of the locality dropped because of their deadlines */
+    inline const plugin::expiry_stats_t &get_expiry_stats() const noexcept {
+        return locality_leader->delivery->get_expiry_stats();
+    }
+
+    /** \brief returns statistics of conflatable messages of the locality */
+    inline const conflation_stats_t &get_conflation_stats() const noexcept {
+        return locality_leader->queue.get_conflation_stats();
+    }
+
+    /** \brief returns message pool of the locality (if it was configured) */
+    inline const message_pool_t *get_message_pool() const noexcept { return locality_leader->message_pool.get(); }
+
+    /** \brief returns recycling allocator of the supervisor (e.g. for coroutine frames of its actors) */
+    inline detail::frame_pool_t &get_frame_pool() noexcept { return frame_pool; }
+
     /** \brief generic non-public fields accessor */
     template <typename T> auto &access() noexcept;
 
     /** \brief generic non-public methods accessor */
     template <typename T, typename... Args> auto access(Args... args) noexcept;
 
-    /** \brief lock-free queue for inbound messages */
-    using inbound_queue_t = boost::lockfree::queue<message_base_t *>;
+    /** \brief intrusive lock-free queue for inbound messages */
+    using inbound_queue_t = rotor::inbound_queue_t;
 
   protected:
     /** \brief creates new address with respect to supervisor locality mark */
     virtual address_ptr_t instantiate_address(const void *locality) noexcept;
 
-    /** \brief timer to response with timeout procedure type */
-    using request_map_t = std::unordered_map<request_id_t, request_curry_t>;
+    /** \brief pending requests table, which generates request ids (type) */
+    using request_map_t = detail::request_table_t;
 
     /** \brief invoked as timer callback; creates response or just clean up for previously set request */
     void on_request_trigger(request_id_t timer_id, bool cancelled) noexcept;
@@ -264,7 +333,47 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     virtual void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept = 0;
 
     /** \brief cancels timer (to be implemented in descendants) */
-    virtual void do_cancel_timer(request_id_t timer_id) noexcept = 0;
+    virtual void do_cancel_timer(timer_handler_base_t &handler) noexcept = 0;
+
+    /** \brief monotonic clock of the timers queue */
+    using timer_clock_t = std::chrono::steady_clock;
+
+    /** \brief timers ordered by deadline (type) */
+    using timers_queue_t = detail::timer_heap_t<timer_clock_t::time_point>;
+
+    /** \brief puts the timer into the timers queue
+     *
+     * Returns `true` if the timer became the earliest one, i.e. the backend
+     * native timer should be re-armed (see `get_timers_deadline`).
+     *
+     * The helper is intended for the backends, which use single native timer
+     * per supervisor.
+     *
+     */
+    bool queue_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept;
+
+    /** \brief removes the timer from the timers queue and invokes it as cancelled
+     *
+     * Returns `true` if the earliest timer has been removed, i.e. the backend
+     * native timer should be re-armed (or stopped, if there are no more timers).
+     *
+     */
+    bool unqueue_timer(timer_handler_base_t &handler) noexcept;
+
+    /** \brief invokes the timers from the queue, which are expired at the `now` time point
+     *
+     * Returns the amount of triggered timers.
+     *
+     */
+    std::size_t trigger_timers(const timer_clock_t::time_point &now) noexcept;
+
+    /** \brief coarse-grained wheel of requests timeouts (type) */
+    using request_wheel_t = detail::timer_wheel_t<timer_clock_t::time_point>;
+
+    /** \brief returns the deadline of the earliest timer (the timers queue must not be empty) */
+    inline const timer_clock_t::time_point &get_timers_deadline() const noexcept {
+        return timers_queue.top().deadline;
+    }
 
     /** \brief intercepts message delivery for the tagged handler */
     virtual void intercept(message_ptr_t &message, const void *tag, const continuation_t &continuation) noexcept;
@@ -272,13 +381,16 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     /** \brief non-owning pointer to system context. */
     system_context_t *context;
 
-    /** \brief queue of unprocessed messages */
-    messages_queue_t queue;
+    /** \brief pool for messages allocated in the locality (optional, owned by locality leader) */
+    message_pool_ptr_t message_pool;
+
+    /** \brief queue of unprocessed messages (a lane per message priority) */
+    message_lanes_t queue;
 
     /** \brief counter for request/timer ids */
     request_id_t last_req_id;
 
-    /** \brief timer to response with timeout procedure */
+    /** \brief pending requests (i.e. timer to response with timeout procedure) */
     request_map_t request_map;
 
     /** \brief main subscription support class  */
@@ -299,8 +411,14 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     /** \brief inbound queue for external messages */
     inbound_queue_t inbound_queue;
 
-    /** \brief size of inbound queue */
-    size_t inbound_queue_size;
+    /** \brief whether inbound queue draining is already scheduled (see `request_wakeup`) */
+    std::atomic_bool wakeup_pending{false};
+
+    /** \brief timers of the supervisor, when backend uses single native timer */
+    timers_queue_t timers_queue;
+
+    /** \brief amount of cached blocks per size class of message pool (zero disables the pool) */
+    size_t message_pool_size;
 
     /** \brief how much time spend in active inbound queue polling */
     pt::time_duration poll_duration;
@@ -311,6 +429,18 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     /** \brief frequency to check atomic shutdown flag */
     pt::time_duration shutdown_poll_frequency = pt::millisec{100};
 
+    /** \brief resolution of the requests timeout wheel (zero: backend timer per request) */
+    pt::time_duration request_tick;
+
+    /** \brief timeouts of the pending requests, when `request_tick` is not zero */
+    request_wheel_t request_wheel;
+
+    /** \brief the id of periodic timer, which advances requests wheel (zero: not started) */
+    request_id_t request_tick_timer = 0;
+
+    /** \brief recycled memory blocks for coroutine frames of the actors */
+    detail::frame_pool_t frame_pool;
+
   private:
     using actors_set_t = std::unordered_set<const actor_base_t *>;
 
@@ -325,25 +455,20 @@ struct ROTOR_API supervisor_t : public actor_base_t {
     address_mapping_t address_mapping;
 
     template <typename T> friend struct request_builder_t;
+    template <typename T, gather_mode_t Mode> friend struct gather_builder_t;
     template <typename Supervisor> friend struct actor_config_builder_t;
     friend struct plugin::delivery_plugin_base_t;
     friend struct actor_base_t;
     template <typename T> friend struct plugin::delivery_plugin_t;
 
     void discard_request(request_id_t request_id) noexcept;
+    void start_request_timer(request_id_t request_id, const pt::time_duration &timeout) noexcept;
+    void on_request_tick(request_id_t, bool cancelled) noexcept;
     void uplift_last_message() noexcept;
 
     void on_shutdown_check_timer(request_id_t, bool cancelled) noexcept;
 
-    inline request_id_t next_request_id() noexcept {
-    AGAIN:
-        auto &map = locality_leader->request_map;
-        auto it = map.find(++locality_leader->last_req_id);
-        if (it != map.end()) {
-            goto AGAIN;
-        }
-        return locality_leader->last_req_id;
-    }
+    inline request_id_t next_request_id() noexcept { return ++locality_leader->last_req_id; }
 };
 
 using supervisor_ptr_t = intrusive_ptr_t<supervisor_t>;
@@ -367,7 +492,24 @@ template <typename Supervisor> auto system_context_t::create_supervisor() {
 }
 
 template <typename M, typename... Args> void actor_base_t::send(const address_ptr_t &addr, Args &&...args) {
-    supervisor->put(make_message<M>(addr, std::forward<Args>(args)...));
+    auto pool = supervisor->locality_leader->message_pool.get();
+    supervisor->put(make_message<M>(pool, addr, std::forward<Args>(args)...));
+}
+
+template <typename M, typename... Args>
+void actor_base_t::send(message_priority_t priority, const address_ptr_t &addr, Args &&...args) {
+    auto pool = supervisor->locality_leader->message_pool.get();
+    auto message = make_message<M>(pool, addr, std::forward<Args>(args)...);
+    message->priority = priority;
+    supervisor->put(std::move(message));
+}
+
+template <typename M, typename... Args>
+void actor_base_t::send(const pt::time_duration &ttl, const address_ptr_t &addr, Args &&...args) {
+    auto pool = supervisor->locality_leader->message_pool.get();
+    auto message = make_message<M>(pool, addr, std::forward<Args>(args)...);
+    message->expires_after(std::chrono::microseconds{ttl.total_microseconds()});
+    supervisor->put(std::move(message));
 }
 
 template <typename Delegate, typename Method>
@@ -440,30 +582,38 @@ subscription_info_ptr_t starter_plugin_t::subscribe_actor(Handler &&handler, con
 
 template <> inline size_t delivery_plugin_t<plugin::local_delivery_t>::process() noexcept {
     size_t enqueued_messages{0};
-    while (queue->size()) {
-        auto message = message_ptr_t(queue->front().detach(), false);
+    while (!queue->empty()) {
+        auto message = queue->pop();
+        if (expired(*message)) {
+            continue;
+        }
         auto &dest = message->address;
-        queue->pop_front();
         auto internal = dest->same_locality(*address);
         if (internal) { /* subscriptions are handled by me */
             auto local_recipients = subscription_map->get_recipients(*message);
             if (local_recipients) {
-                plugin::local_delivery_t::delivery(message, *local_recipients);
+                plugin::local_delivery_t::delivery(*this, message, *local_recipients);
             }
         } else {
-            dest->supervisor.enqueue(std::move(message));
+            handoff(message);
             ++enqueued_messages;
         }
+        handoff_step();
+    }
+    if (!handoff_batches.empty()) {
+        flush_handoffs();
     }
     return enqueued_messages;
 }
 
 template <> inline size_t delivery_plugin_t<plugin::inspected_local_delivery_t>::process() noexcept {
     size_t enqueued_messages{0};
-    while (queue->size()) {
-        auto message = message_ptr_t(queue->front().detach(), false);
+    while (!queue->empty()) {
+        auto message = queue->pop();
+        if (expired(*message)) {
+            continue;
+        }
         auto &dest = message->address;
-        queue->pop_front();
         auto internal = dest->same_locality(*address);
         const subscription_t::joint_handlers_t *local_recipients = nullptr;
         bool delivery_attempt = false;
@@ -471,16 +621,20 @@ template <> inline size_t delivery_plugin_t<plugin::inspected_local_delivery_t>:
             local_recipients = subscription_map->get_recipients(*message);
             delivery_attempt = true;
         } else {
-            dest->supervisor.enqueue(std::move(message));
+            handoff(message);
             ++enqueued_messages;
         }
         if (local_recipients) {
-            plugin::inspected_local_delivery_t::delivery(message, *local_recipients);
+            plugin::inspected_local_delivery_t::delivery(*this, message, *local_recipients);
         } else {
             if (delivery_attempt) {
                 plugin::inspected_local_delivery_t::discard(message);
             }
         }
+        handoff_step();
+    }
+    if (!handoff_batches.empty()) {
+        flush_handoffs();
     }
     return enqueued_messages;
 }
@@ -500,51 +654,95 @@ template <typename T>
 template <typename... Args>
 request_builder_t<T>::request_builder_t(supervisor_t &sup_, actor_base_t &actor_, const address_ptr_t &destination_,
                                         const address_ptr_t &reply_to_, Args &&...args)
-    : sup{sup_}, actor{actor_}, request_id{sup.next_request_id()}, destination{destination_}, reply_to{reply_to_},
-      do_install_handler{false} {
-    auto addr = sup.address_mapping.get_mapped_address(actor_, response_message_t::message_type);
-    if (addr) {
-        imaginary_address = addr;
-    } else {
-        // subscribe to imaginary address instead of real one because of
-        // 1. faster dispatching
-        // 2. need to distinguish between "timeout guarded responses" and "responses to own requests"
-        imaginary_address = sup.make_address();
-        do_install_handler = true;
-    }
-    req.reset(
-        new request_message_t{destination, request_id, imaginary_address, reply_to_, std::forward<Args>(args)...});
+    : sup{sup_}, actor{actor_}, request_id{0}, destination{destination_}, reply_to{reply_to_},
+      do_install_handler{false}, imaginary_address{imaginary_address_of(sup_, actor_, do_install_handler)} {
+    auto pool = sup.locality_leader->message_pool.get();
+    req.reset(new (pool) request_message_t{destination, request_id, imaginary_address, reply_to_,
+                                           std::forward<Args>(args)...});
+}
+
+template <typename T>
+template <typename... Args>
+request_builder_t<T>::request_builder_t(const address_ptr_t &response_address, supervisor_t &sup_,
+                                        actor_base_t &actor_, const address_ptr_t &destination_,
+                                        const address_ptr_t &reply_to_, Args &&...args)
+    : sup{sup_}, actor{actor_}, request_id{0}, destination{destination_}, reply_to{reply_to_},
+      do_install_handler{false}, imaginary_address{response_address} {
+    auto pool = sup.locality_leader->message_pool.get();
+    req.reset(new (pool) request_message_t{destination, request_id, imaginary_address, reply_to_,
+                                           std::forward<Args>(args)...});
 }
 
 template <typename T> request_id_t request_builder_t<T>::send(const pt::time_duration &timeout) noexcept {
     if (do_install_handler) {
-        install_handler();
+        install_handler(sup, actor, imaginary_address);
     }
     auto fn = &request_traits_t<T>::make_error_response;
-    sup.request_map.emplace(request_id, request_curry_t{fn, reply_to, req, &actor});
+    auto curry = request_curry_t{fn, reply_to, req, &actor, response_sink};
+    request_id = sup.request_map.emplace(std::move(curry), actor.active_requests);
+    req->payload.id = request_id;
     sup.put(req);
-    sup.start_timer(request_id, timeout, sup, &supervisor_t::on_request_trigger);
-    actor.active_requests.emplace(request_id);
+    sup.start_request_timer(request_id, timeout);
     return request_id;
 }
 
-template <typename T> void request_builder_t<T>::install_handler() noexcept {
+template <typename T> request_builder_t<T> &request_builder_t<T>::ttl(const pt::time_duration &ttl) noexcept {
+    req->expires_after(std::chrono::microseconds{ttl.total_microseconds()});
+    return *this;
+}
+
+template <typename T> request_builder_t<T> &request_builder_t<T>::sink(response_sink_t &sink) noexcept {
+    response_sink = &sink;
+    return *this;
+}
+
+template <typename T>
+address_ptr_t request_builder_t<T>::imaginary_address_of(supervisor_t &sup, actor_base_t &actor,
+                                                         bool &do_install) noexcept {
+    auto addr = sup.address_mapping.get_mapped_address(actor, response_message_t::message_type);
+    if (addr) {
+        return addr;
+    }
+    // subscribe to imaginary address instead of real one because of
+    // 1. faster dispatching
+    // 2. need to distinguish between "timeout guarded responses" and "responses to own requests"
+    do_install = true;
+    return sup.make_address();
+}
+
+template <typename T>
+void request_builder_t<T>::install_handler(supervisor_t &sup, actor_base_t &actor,
+                                           const address_ptr_t &imaginary_address) noexcept {
     auto handler = lambda<response_message_t>([supervisor = &sup](response_message_t &msg) {
         auto request_id = msg.payload.request_id();
-        auto &request_map = supervisor->request_map;
-        auto it = request_map.find(request_id);
+        auto curry = supervisor->request_map.find(request_id);
 
         // if a response to request has arrived and no timer can be found
         // that means that either timeout timer already triggered
         // and error-message already delivered or response is not expected.
         // just silently drop it anyway
-        if (it != request_map.end()) {
-            auto &curry = it->second;
-            auto &orig_addr = curry.origin;
-            supervisor->template send<wrapped_res_t>(orig_addr, msg.payload);
+        if (curry) {
+            if (auto collector = curry->collector; collector) {
+                collector(*supervisor, *curry, msg);
+                return;
+            }
+            if (auto sink = curry->sink; sink) {
+                supervisor->discard_request(request_id);
+                sink->on_response(request_id, msg);
+                return;
+            }
+            auto &orig_addr = curry->origin;
+            if (msg.use_count() == 1) {
+                // nobody else refers the response, so it is re-addressed in place
+                // (zero-copy) and delivered immediately to keep order
+                msg.address = orig_addr;
+                supervisor->locality_leader->queue.emplace_front(&msg);
+            } else {
+                supervisor->template send<wrapped_res_t>(orig_addr, msg.payload);
+                // keep order, i.e. deliver response immediately
+                supervisor->uplift_last_message();
+            }
             supervisor->discard_request(request_id);
-            // keep order, i.e. deliver response immediately
-            supervisor->uplift_last_message();
         }
     });
     auto wrapped_handler = wrap_handler(sup, std::move(handler));
@@ -552,6 +750,117 @@ template <typename T> void request_builder_t<T>::install_handler() noexcept {
     sup.address_mapping.set(actor, info);
 }
 
+template <typename T, gather_mode_t Mode>
+template <typename... Args>
+gather_builder_t<T, Mode>::gather_builder_t(supervisor_t &sup_, actor_base_t &actor_,
+                                            const std::vector<address_ptr_t> &destinations,
+                                            const address_ptr_t &reply_to_, Args &&...args)
+    : sup{sup_}, actor{actor_}, reply_to{reply_to_}, do_install_handler{false},
+      imaginary_address{request_builder_t<T>::imaginary_address_of(sup_, actor_, do_install_handler)} {
+    assert(!destinations.empty() && "request is scattered to some addresses");
+    assert(unique(destinations) && "request is scattered to distinct addresses");
+    auto pool = sup.locality_leader->message_pool.get();
+    gathered.reset(new (pool) gathered_message_t{reply_to});
+    auto &payload = gathered->payload;
+    auto count = destinations.size();
+    payload.requests.reserve(count);
+    payload.responses.resize(count);
+    payload.pending = count;
+    for (auto &destination : destinations) {
+        auto req = new (pool) request_message_t{destination, request_id_t{0}, imaginary_address, reply_to, args...};
+        payload.requests.emplace_back(req);
+    }
+}
+
+template <typename T, gather_mode_t Mode>
+request_id_t gather_builder_t<T, Mode>::send(const pt::time_duration &timeout) noexcept {
+    if (do_install_handler) {
+        request_builder_t<T>::install_handler(sup, actor, imaginary_address);
+    }
+    auto curry = request_curry_t{&make_error_response, reply_to, gathered, &actor, nullptr, &collect};
+    auto request_id = sup.request_map.emplace(std::move(curry), actor.active_requests);
+    auto &payload = gathered->payload;
+    payload.id = request_id;
+    for (auto &req : payload.requests) {
+        req->payload.id = request_id;
+        sup.put(req);
+    }
+    sup.start_request_timer(request_id, timeout);
+    return request_id;
+}
+
+template <typename T, gather_mode_t Mode>
+gather_builder_t<T, Mode> &gather_builder_t<T, Mode>::ttl(const pt::time_duration &ttl) noexcept {
+    for (auto &req : gathered->payload.requests) {
+        req->expires_after(std::chrono::microseconds{ttl.total_microseconds()});
+    }
+    return *this;
+}
+
+template <typename T, gather_mode_t Mode>
+message_ptr_t gather_builder_t<T, Mode>::make_error_response(const address_ptr_t &, message_base_t &message,
+                                                             const extended_error_ptr_t &ee) noexcept {
+    auto &gathered = static_cast<gathered_message_t &>(message);
+    auto &payload = gathered.payload;
+    payload.ee = ee;
+    cancel_pending(payload);
+    return message_ptr_t{&gathered};
+}
+
+template <typename T, gather_mode_t Mode>
+void gather_builder_t<T, Mode>::cancel_pending(gathered_t &payload) noexcept {
+    auto &requests = payload.requests;
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        if (!payload.responses[i]) {
+            auto &req = requests[i];
+            // the responses are routed via the (imaginary) address of the requesting supervisor
+            auto &sup = req->payload.reply_to->supervisor;
+            sup.template send<cancel_payload_t>(req->address, payload.id, req->payload.origin);
+        }
+    }
+}
+
+template <typename T, gather_mode_t Mode>
+bool gather_builder_t<T, Mode>::unique(const std::vector<address_ptr_t> &destinations) noexcept {
+    for (auto it = destinations.begin(); it != destinations.end(); ++it) {
+        if (std::find(std::next(it), destinations.end(), *it) != destinations.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, gather_mode_t Mode>
+void gather_builder_t<T, Mode>::collect(supervisor_t &sup, request_curry_t &curry, message_base_t &response) noexcept {
+    auto &res = static_cast<response_message_t &>(response);
+    auto &payload = static_cast<gathered_message_t &>(*curry.request_message).payload;
+    auto &requests = payload.requests;
+    auto it = std::find(requests.begin(), requests.end(), res.payload.req);
+    if (it == requests.end()) {
+        return;
+    }
+    auto &slot = payload.responses[static_cast<std::size_t>(it - requests.begin())];
+    if (slot) {
+        return;
+    }
+    slot.reset(&res);
+    auto done = --payload.pending == 0;
+    if constexpr (Mode == gather_mode_t::any) {
+        if (!res.payload.ee) {
+            payload.response.reset(&res);
+            done = true;
+            cancel_pending(payload);
+        } else if (done) {
+            payload.ee = res.payload.ee;
+        }
+    }
+    if (done) {
+        message_ptr_t gathered = curry.request_message;
+        sup.discard_request(payload.id);
+        sup.put(std::move(gathered));
+    }
+}
+
 /** \brief makes an request to the destination address with the message constructed from `args`
  *
  * The `reply_to` address is defaulted to actor's main address.1
@@ -577,6 +886,32 @@ actor_base_t::request_via(const address_ptr_t &dest_addr, const address_ptr_t &r
     return supervisor->do_request<request_t>(*this, dest_addr, reply_addr, std::forward<Args>(args)...);
 }
 
+/** \brief makes the request, scattered to the destination addresses, which gathers all the responses
+ *
+ * The aggregated response is delivered to actor's main address.
+ *
+ */
+template <typename Request, typename... Args>
+gather_builder_t<typename request_wrapper_t<Request>::request_t, gather_mode_t::all>
+actor_base_t::request_all(const std::vector<address_ptr_t> &dest_addrs, Args &&...args) {
+    using request_t = typename request_wrapper_t<Request>::request_t;
+    using builder_t = gather_builder_t<request_t, gather_mode_t::all>;
+    return builder_t(*supervisor, *this, dest_addrs, address, std::forward<Args>(args)...);
+}
+
+/** \brief makes the request, scattered to the destination addresses, where the first successful response wins
+ *
+ * The aggregated response is delivered to actor's main address.
+ *
+ */
+template <typename Request, typename... Args>
+gather_builder_t<typename request_wrapper_t<Request>::request_t, gather_mode_t::any>
+actor_base_t::request_any(const std::vector<address_ptr_t> &dest_addrs, Args &&...args) {
+    using request_t = typename request_wrapper_t<Request>::request_t;
+    using builder_t = gather_builder_t<request_t, gather_mode_t::any>;
+    return builder_t(*supervisor, *this, dest_addrs, address, std::forward<Args>(args)...);
+}
+
 template <typename Request> auto actor_base_t::make_response(Request &message, const extended_error_ptr_t &ec) {
     using payload_t = typename Request::payload_t::request_t;
     using traits_t = request_traits_t<payload_t>;
@@ -41,10 +41,15 @@ struct supervisor_config_t : actor_config_t {
      */
     address_ptr_t registry_address;
 
-    /** \brief initial queue size for inbound messages. Makes sense only for
-     *  root/leader supervisor */
+    /** \brief not used: the inbound queue is unbounded intrusive queue
+     *  since v0.27, left for the source compatibility */
     size_t inbound_queue_size = 64;
 
+    /** \brief amount of cached memory blocks per size class in the messages pool
+     *  of the locality. Zero disables the pool. Makes sense only for
+     *  root/leader supervisor */
+    size_t message_pool_size = 0;
+
     /**
      * \brief How much time it will spend in polling inbound queue before switching into
      * sleep mode (i.e. waiting external messages).
@@ -66,6 +71,18 @@ struct supervisor_config_t : actor_config_t {
 
     /** \brief the period for checking atomic shutdown flag */
     pt::time_duration shutdown_poll_frequency = pt::millisec{100};
+
+    /** \brief resolution of the requests timeout wheel
+     *
+     * The timeouts of the requests are tracked by the supervisor in the coarse-grained
+     * wheel, which is advanced by single periodic backend timer, instead of spawning
+     * backend timer per request. A request might time out up to two ticks later than
+     * requested.
+     *
+     * The wheel is opt-in: zero value (the default) means backend timer per request.
+     *
+     */
+    pt::time_duration request_tick = pt::time_duration{};
 };
 
 /** \brief CRTP supervisor config builder */
@@ -102,13 +119,20 @@ template <typename Supervisor> struct supervisor_config_builder_t : actor_config
         return std::move(*static_cast<typename parent_t::builder_t *>(this));
     }
 
-    /** \brief initial queue size for inbound messages. Makes sense only for
-     *  root/leader supervisor */
+    /** \brief not used: the inbound queue is unbounded intrusive queue
+     *  since v0.27, left for the source compatibility */
     builder_t &&inbound_queue_size(size_t value) && {
         parent_t::config.inbound_queue_size = value;
         return std::move(*static_cast<builder_t *>(this));
     }
 
+    /** \brief amount of cached memory blocks per size class in the messages pool.
+     *  Makes sense only for root/leader supervisor */
+    builder_t &&message_pool_size(size_t value) && {
+        parent_t::config.message_pool_size = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
     /** \brief how much time spend in active inbound queue polling */
     builder_t &&poll_duration(const pt::time_duration &value) && {
         parent_t::config.poll_duration = value;
@@ -131,6 +155,12 @@ template <typename Supervisor> struct supervisor_config_builder_t : actor_config
         return std::move(*static_cast<builder_t *>(this));
     }
 
+    /** \brief resolution of the requests timeout wheel (zero: backend timer per request) */
+    builder_t &&request_tick(const pt::time_duration &value) && {
+        parent_t::config.request_tick = value;
+        return std::move(*static_cast<builder_t *>(this));
+    }
+
     virtual bool validate() noexcept {
         bool r = parent_t::validate();
         if (r) {
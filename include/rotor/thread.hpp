@@ -10,6 +10,7 @@
  * A convenience header to include rotor support for pure thread backends
  */
 
+#include "rotor/thread/idle_strategy.h"
 #include "rotor/thread/supervisor_thread.h"
 #include "rotor/thread/system_context_thread.h"
 
@@ -0,0 +1,66 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/thread/export.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace rotor {
+namespace thread {
+
+/** \struct event_count_t
+ *  \brief lets single consumer park until producers signal, producers pay the syscall only when it is parked
+ *
+ * The consumer registers itself via `prepare_wait`, re-checks its condition (e.g.
+ * inbound queue emptiness) and then either `cancel_wait`s or `wait`s. Producers
+ * make the condition true and then invoke `notify`, which is a fence and a
+ * single load, unless there is a registered waiter.
+ *
+ * On Linux the waiter is parked on `futex`, otherwise mutex and condition
+ * variable are used.
+ *
+ */
+struct ROTOR_THREAD_API event_count_t {
+    /** \brief an alias for monotonic clock */
+    using clock_t = std::chrono::steady_clock;
+
+    /** \brief registers waiter and returns the key to be passed to `wait` */
+    std::uint32_t prepare_wait() noexcept;
+
+    /** \brief unregisters waiter, when the condition became true after `prepare_wait` */
+    void cancel_wait() noexcept;
+
+    /** \brief parks until `notify` after `prepare_wait` or the deadline, and unregisters waiter */
+    void wait(std::uint32_t key, const clock_t::time_point &deadline) noexcept;
+
+    /** \brief wakes up the registered waiter (if any) */
+    void notify() noexcept;
+
+  private:
+    std::atomic<std::uint32_t> waiters{0};
+    std::atomic<std::uint32_t> epoch{0};
+#if !defined(__linux__)
+    std::mutex mutex;
+    std::condition_variable cv;
+#endif
+};
+
+} // namespace thread
+} // namespace rotor
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
@@ -0,0 +1,92 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace rotor {
+namespace thread {
+
+/** \brief how the thread polls inbound queue before it parks */
+enum class idle_strategy_t : std::uint8_t {
+    /** \brief polls in tight loop */
+    busy_spin,
+    /** \brief polls with cpu relax hint (`pause`/`yield` instruction) between attempts */
+    pause_spin,
+    /** \brief polls with exponentially growing (bounded) amount of relax hints between attempts */
+    backoff,
+    /** \brief does not poll, parks immediately */
+    park,
+};
+
+/** \brief hints CPU, that the current thread is spinning */
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#endif
+}
+
+/** \struct spin_budget_t
+ *  \brief how long to poll before parking, tuned from the observed message inter-arrival time
+ *
+ * Polling pays off, when the next message arrives sooner than the thread would
+ * be parked and woken up again. The average (EWMA) idle gap is tracked; while
+ * it is short, the budget is twice the average, bounded by `max`. When messages
+ * arrive more rarely than `max`, the budget drops to zero, i.e. the thread parks
+ * immediately and does not burn CPU.
+ *
+ */
+struct spin_budget_t {
+    /** \brief an alias for the budget precision */
+    using duration_t = std::chrono::nanoseconds;
+
+    /** \brief constructs budget; non-adaptive budget is always `max` */
+    spin_budget_t(duration_t max_, bool adaptive_) noexcept
+        : max{max_}, value{max_}, average{max_ / 2}, adaptive{adaptive_} {}
+
+    /** \brief takes into account idle gap, which ended with a message arrival */
+    inline void update(duration_t gap) noexcept {
+        if (!adaptive) {
+            return;
+        }
+        // long gaps (i.e. parking) are capped, to let the budget recover fast on bursts
+        auto cap = max * 4;
+        if (gap > cap) {
+            gap = cap;
+        }
+        average += (gap - average) / 8;
+        if (average >= max) {
+            value = duration_t::zero();
+        } else {
+            value = average * 2 < max ? average * 2 : max;
+        }
+    }
+
+    /** \brief the maximum polling duration */
+    duration_t max;
+
+    /** \brief the current polling duration */
+    duration_t value;
+
+    /** \brief average idle gap */
+    duration_t average;
+
+    /** \brief whether the budget is tuned */
+    bool adaptive;
+};
+
+} // namespace thread
+} // namespace rotor
@@ -9,11 +9,11 @@
 #include "rotor/arc.hpp"
 #include "rotor/system_context.h"
 #include "rotor/timer_handler.hpp"
+#include "rotor/detail/timer_heap.h"
+#include "rotor/thread/event_count.h"
 #include "rotor/thread/export.h"
+#include "rotor/thread/idle_strategy.h"
 #include <chrono>
-#include <condition_variable>
-#include <list>
-#include <mutex>
 #include <thread>
 
 #if defined(_MSC_VER)
@@ -32,16 +32,24 @@ using supervisor_ptr_t = intrusive_ptr_t<supervisor_thread_t>;
 /** \struct system_context_thread_t
  *  \brief The thread system context, for blocking operations
  *
+ * When there are no messages, the thread polls inbound queue for `poll_duration`
+ * (supervisor config option) in the way defined by {@link idle_strategy_t}, and
+ * then parks until a message arrives or the nearest timer expires. If the polling
+ * is adaptive, the polling duration is tuned from the observed message inter-arrival
+ * time (see {@link spin_budget_t}).
+ *
+ * Producers (other threads) wake the thread only if it is parked.
+ *
  */
 struct ROTOR_THREAD_API system_context_thread_t : public system_context_t {
     /** \brief constructs thread system context
      *
-     *  \param queue_size defines pre-allocated inbound queue size for messages from other threads
+     *  \param idle_strategy how inbound queue is polled before parking
      *
-     *  \param poll_time how much time it will spend in polling inbound queue before switching into
-     *  notification mode (i.e. cv + mutex)
+     *  \param adaptive whether the polling duration is tuned from the observed message inter-arrival
+     *  time (otherwise it is always `poll_duration`)
      */
-    system_context_thread_t() noexcept;
+    system_context_thread_t(idle_strategy_t idle_strategy = idle_strategy_t::backoff, bool adaptive = true) noexcept;
 
     /** \brief invokes blocking execution of the supervisor
      *
@@ -53,45 +61,48 @@ struct ROTOR_THREAD_API system_context_thread_t : public system_context_t {
     /** \brief checks for messages from external threads and fires expired timers */
     void check() noexcept;
 
+    /** \brief returns the idle strategy */
+    inline idle_strategy_t get_idle_strategy() const noexcept { return idle_strategy; }
+
+    /** \brief returns the current polling budget */
+    inline const spin_budget_t &get_spin_budget() const noexcept { return budget; }
+
   protected:
     /** \brief an alias for monotonic clock */
     using clock_t = std::chrono::steady_clock;
 
-    /** \struct deadline_info_t
-     *  \brief struct to keep timer handlers
-     */
-    struct deadline_info_t {
-        /** \brief non-owning pointer to timer handler  */
-        timer_handler_base_t *handler;
-
-        /** \brief time point, after which the timer is considered expired */
-        clock_t::time_point deadline;
-    };
-
-    /** \brief ordered list of deadline infos (type) */
-    using list_t = std::list<deadline_info_t>;
+    /** \brief timers ordered by deadline (type) */
+    using timers_t = detail::timer_heap_t<clock_t::time_point>;
 
     /** \brief fires handlers for expired timers */
     void update_time() noexcept;
 
+    /** \brief polls and then parks until messages or the nearest timer deadline */
+    void idle() noexcept;
+
+    /** \brief polls inbound queue until the deadline, returns `true` if messages have arrived */
+    bool spin(const clock_t::time_point &deadline) noexcept;
+
     /** \brief start timer implementation */
     void start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept;
 
     /** \brief cancel timer implementation */
+    void cancel_timer(timer_handler_base_t &handler) noexcept;
 
-    void cancel_timer(request_id_t timer_id) noexcept;
+    /** \brief parking place of the thread, notified upon pushing messages into inbound queue */
+    event_count_t events;
 
-    /** \brief mutex for inbound queue */
-    std::mutex mutex;
+    /** \brief how inbound queue is polled before parking */
+    idle_strategy_t idle_strategy;
 
-    /** \brief cv for notifying about pushing messages into inbound queue */
-    std::condition_variable cv;
+    /** \brief polling duration */
+    spin_budget_t budget;
 
     /** \brief current time */
     clock_t::time_point now;
 
-    /** \brief ordered list of deadline infos */
-    list_t timer_nodes;
+    /** \brief timers ordered by deadline */
+    timers_t timers;
 
     /** \brief whether the context is intercepting blocking (I/O) handler */
     bool intercepting = false;
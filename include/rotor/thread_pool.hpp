@@ -0,0 +1,21 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/** \file thread_pool.hpp
+ * A convenience header to include rotor support for thread pool backend
+ */
+
+#include "rotor/thread_pool/supervisor_thread_pool.h"
+#include "rotor/thread_pool/system_context_thread_pool.h"
+
+namespace rotor {
+
+/// namespace for thread pool backend (M:N scheduling of supervisors on worker threads) for `rotor`
+namespace thread_pool {}
+
+} // namespace rotor
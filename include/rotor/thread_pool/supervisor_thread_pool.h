@@ -0,0 +1,89 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/supervisor.h"
+#include "rotor/thread_pool/export.h"
+#include "system_context_thread_pool.h"
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace rotor {
+namespace thread_pool {
+
+/** \struct supervisor_thread_pool_t
+ *  \brief supervisor, which is executed by the workers of {@link system_context_thread_pool_t}
+ *
+ * Each thread pool supervisor is a locality on its own, i.e. a schedulable unit
+ * with its own inbound queue and timers. When a message arrives to the inbound
+ * queue, the supervisor is scheduled on the pool, and any idle worker may pick
+ * it up (work stealing). The supervisor is never executed by more than one
+ * worker at a time, so its actors are still executed sequentially, like on any
+ * other backend.
+ *
+ * Non-supervisor actors (and the supervisors with the shared locality) are
+ * executed as the part of the supervisor locality.
+ *
+ */
+struct ROTOR_THREAD_POOL_API supervisor_thread_pool_t : public supervisor_t {
+    /** \brief constructs new thread pool supervisor */
+    inline supervisor_thread_pool_t(supervisor_config_t &cfg) : supervisor_t{cfg} {}
+
+    address_ptr_t make_address() noexcept override;
+    void start() noexcept override;
+    void shutdown() noexcept override;
+    void enqueue(message_ptr_t message) noexcept override;
+    void enqueue_batch(message_base_t *first) noexcept override;
+
+    void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
+
+  protected:
+    /** \brief scheduling state of the supervisor (locality) on the pool */
+    enum class unit_state_t : std::uint8_t {
+        /** \brief there is nothing to process */
+        IDLE,
+        /** \brief the supervisor is in the run queue of some worker */
+        SCHEDULED,
+        /** \brief the supervisor is being executed by some worker */
+        RUNNING,
+        /** \brief new messages arrived during execution, it should be re-scheduled */
+        NOTIFIED,
+    };
+
+    /** \brief notifies the pool about new messages in the inbound queue */
+    void wakeup() noexcept;
+
+    /** \brief drains inbound queue, fires expired timers and processes messages
+     *
+     * Returns `true` if the supervisor has been shut down.
+     */
+    bool process_unit() noexcept;
+
+    /** \brief scheduling state of the supervisor */
+    std::atomic<unit_state_t> unit_state{unit_state_t::IDLE};
+
+    /** \brief whether the earliest timer deadline is registered in the pool */
+    bool armed = false;
+
+    /** \brief the earliest timer deadline registered in the pool */
+    timer_clock_t::time_point armed_deadline;
+
+    friend struct system_context_thread_pool_t;
+};
+
+} // namespace thread_pool
+} // namespace rotor
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
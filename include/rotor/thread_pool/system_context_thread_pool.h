@@ -0,0 +1,162 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/arc.hpp"
+#include "rotor/system_context.h"
+#include "rotor/thread_pool/export.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4251)
+#endif
+
+namespace rotor {
+namespace thread_pool {
+
+struct supervisor_thread_pool_t;
+
+/** \brief intrusive pointer for thread pool supervisor */
+using supervisor_ptr_t = intrusive_ptr_t<supervisor_thread_pool_t>;
+
+/** \struct system_context_thread_pool_t
+ *  \brief The thread pool system context (M:N scheduling of supervisors on worker threads)
+ *
+ * The context runs N worker threads; each {@link supervisor_thread_pool_t} is a
+ * schedulable unit. Each worker has own run queue: the units, which became ready
+ * on the worker, are pushed there, and an idle worker steals the units from the
+ * other workers queues. Units, which became ready outside of the pool, are
+ * injected via the shared queue. A unit is executed by one worker at a time.
+ *
+ * The workers, which have nothing to do, sleep until a unit becomes ready or
+ * the earliest timer of the units expires.
+ *
+ */
+struct ROTOR_THREAD_POOL_API system_context_thread_pool_t : public system_context_t {
+    /** \brief constructs thread pool system context
+     *
+     *  \param workers_count the amount of worker threads, zero means `std::thread::hardware_concurrency()`
+     */
+    explicit system_context_thread_pool_t(std::size_t workers_count = 0) noexcept;
+
+    /** \brief invokes blocking execution of the supervisors on the pool
+     *
+     * The calling thread becomes the first worker. It blocks until root
+     * supervisor shuts down.
+     *
+     */
+    virtual void run() noexcept;
+
+    /** \brief returns the amount of worker threads */
+    inline std::size_t get_workers_count() const noexcept { return workers.size(); }
+
+  protected:
+    /** \brief an alias for monotonic clock */
+    using clock_t = std::chrono::steady_clock;
+
+    /** \brief run queue of units */
+    using units_t = std::deque<supervisor_thread_pool_t *>;
+
+    /** \struct worker_t
+     *  \brief worker own run queue; the owner takes units from the back, thieves from the front
+     */
+    struct worker_t {
+        /** \brief run queue guard */
+        std::mutex mutex;
+
+        /** \brief the ready units */
+        units_t units;
+    };
+
+    /** \brief unique pointer to worker */
+    using worker_ptr_t = std::unique_ptr<worker_t>;
+
+    /** \brief workers (type) */
+    using workers_t = std::vector<worker_ptr_t>;
+
+    /** \brief earliest timer deadlines of the units (type) */
+    using deadlines_t = std::set<std::pair<clock_t::time_point, supervisor_thread_pool_t *>>;
+
+    /** \brief marks the unit as ready (thread-safe); schedules it, unless it is already scheduled or running */
+    void notify(supervisor_thread_pool_t &unit) noexcept;
+
+    /** \brief puts the unit into run queue and wakes up a sleeping worker (if any) */
+    void schedule(supervisor_thread_pool_t &unit, bool front = false) noexcept;
+
+    /** \brief takes ready unit from own run queue, the injected queue or steals it from other workers */
+    supervisor_thread_pool_t *acquire(std::size_t worker_index) noexcept;
+
+    /** \brief executes the unit and re-schedules it, if it has been notified during execution */
+    void execute(supervisor_thread_pool_t &unit) noexcept;
+
+    /** \brief (re)registers the earliest timer deadline of the unit */
+    void arm(supervisor_thread_pool_t &unit) noexcept;
+
+    /** \brief notifies the units with expired timers, returns `true` if there were some */
+    bool fire_deadlines() noexcept;
+
+    /** \brief worker main loop */
+    void work(std::size_t worker_index) noexcept;
+
+    /** \brief makes all workers leave their loops */
+    void stop() noexcept;
+
+    /** \brief workers run queues */
+    workers_t workers;
+
+    /** \brief guard of the injected units */
+    std::mutex injected_mutex;
+
+    /** \brief the units, which became ready outside of the pool */
+    units_t injected;
+
+    /** \brief amount of units in all run queues */
+    std::atomic_size_t pending{0};
+
+    /** \brief amount of sleeping workers */
+    std::atomic_size_t sleepers{0};
+
+    /** \brief mutex for sleeping workers */
+    std::mutex mutex;
+
+    /** \brief cv for notifying sleeping workers */
+    std::condition_variable cv;
+
+    /** \brief guard of timer deadlines */
+    std::mutex deadlines_mutex;
+
+    /** \brief earliest timer deadlines of the units */
+    deadlines_t deadlines;
+
+    /** \brief whether the workers should leave their loops */
+    std::atomic_bool stopping{false};
+
+    /** \brief non-owning pointer to root supervisor during `run` */
+    supervisor_thread_pool_t *root = nullptr;
+
+    friend struct supervisor_thread_pool_t;
+};
+
+/** \brief intrusive pointer type for thread pool system context */
+using system_context_ptr_t = rotor::intrusive_ptr_t<system_context_thread_pool_t>;
+
+} // namespace thread_pool
+} // namespace rotor
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
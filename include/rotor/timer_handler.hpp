@@ -22,6 +22,12 @@ struct timer_handler_base_t {
     /** \brief timer identity (aka timer request id) */
     request_id_t request_id;
 
+    /** \brief "no position" value of `queue_index` */
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /** \brief position of the timer in the backend timers queue (if the backend maintains it) */
+    std::size_t queue_index = npos;
+
     /** \brief constructs timer handler from non-owning pointer to timer and timer request id */
     timer_handler_base_t(actor_base_t *owner_, request_id_t request_id_) noexcept
         : owner{owner_}, request_id{request_id_} {}
@@ -0,0 +1,22 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+/** \file uring.hpp
+ * A convenience header to include rotor support for io_uring backend
+ */
+
+#include "rotor/uring/messages.hpp"
+#include "rotor/uring/supervisor_uring.h"
+#include "rotor/uring/system_context_uring.h"
+
+namespace rotor {
+
+/// namespace for io_uring backend (Linux) for `rotor`
+namespace uring {}
+
+} // namespace rotor
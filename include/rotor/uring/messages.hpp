@@ -0,0 +1,63 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/message.h"
+#include <cstdint>
+#include <system_error>
+
+namespace rotor {
+namespace uring {
+
+/** \brief identifies asynchronous I/O operation */
+using io_id_t = std::uint64_t;
+
+/** \brief kind of asynchronous I/O operation */
+enum class io_operation_t : std::uint8_t { read, write, accept, connect };
+
+/// namespace for io_uring backend payloads
+namespace payload {
+
+/** \struct io_completion_t
+ *  \brief the result of asynchronous I/O operation
+ *
+ * The message is delivered to the address, which has been specified upon
+ * the operation start, from the event loop thread.
+ *
+ */
+struct io_completion_t {
+    /** \brief operation identity, as it was returned upon operation start */
+    io_id_t id;
+
+    /** \brief the kind of operation */
+    io_operation_t operation;
+
+    /** \brief the file descriptor of the operation */
+    int fd;
+
+    /** \brief the amount of transferred bytes (read, write), the accepted socket (accept),
+     * zero (connect), or negated `errno` on failure */
+    std::int32_t result;
+
+    /** \brief returns the error of the operation (if any) */
+    inline std::error_code ec() const noexcept {
+        return result < 0 ? std::error_code(-result, std::system_category()) : std::error_code{};
+    }
+};
+
+} // namespace payload
+
+/// namespace for io_uring backend messages
+namespace message {
+
+/** \brief asynchronous I/O operation completion */
+using io_completion_t = message_t<payload::io_completion_t>;
+
+} // namespace message
+
+} // namespace uring
+} // namespace rotor
@@ -0,0 +1,88 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/uring/export.h"
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <linux/io_uring.h>
+#include <system_error>
+
+namespace rotor {
+namespace uring {
+
+/** \struct ring_t
+ *  \brief minimal wrapper around io_uring submission and completion queues
+ *
+ * The ring is set up and entered via raw system calls, i.e. no `liburing`
+ * is needed. It is not thread-safe, and is owned by a single event loop.
+ *
+ */
+struct ROTOR_URING_API ring_t {
+    /** \brief user data of completions, which should be ignored (e.g. internal timeouts) */
+    static constexpr std::uint64_t ignored_tag = 0;
+
+    ring_t() noexcept = default;
+    ring_t(const ring_t &) = delete;
+    ring_t(ring_t &&) = delete;
+    ~ring_t();
+
+    /** \brief creates the ring with the given amount of submission queue entries */
+    std::error_code setup(std::uint32_t entries) noexcept;
+
+    /** \brief returns the next zeroed submission queue entry or `nullptr`, if the queue is full */
+    io_uring_sqe *get_sqe() noexcept;
+
+    /** \brief submits the prepared entries and waits for at least `wait_nr` completions
+     *
+     * If `timeout` is not `nullptr` the waiting is limited by the timeout. Returns
+     * the amount of submitted entries or negated `errno`.
+     *
+     */
+    int submit(std::uint32_t wait_nr, const std::chrono::nanoseconds *timeout) noexcept;
+
+    /** \brief returns the next available completion or `nullptr` */
+    io_uring_cqe *peek_cqe() noexcept;
+
+    /** \brief marks the completion returned by `peek_cqe` as consumed */
+    void cqe_seen() noexcept;
+
+    /** \brief returns the ring file descriptor (`-1` if the ring is not set up) */
+    inline int get_fd() const noexcept { return fd; }
+
+  private:
+    void release() noexcept;
+
+    int fd = -1;
+    std::uint32_t features = 0;
+
+    void *sq_ring = nullptr;
+    std::size_t sq_ring_size = 0;
+    void *cq_ring = nullptr;
+    std::size_t cq_ring_size = 0;
+    io_uring_sqe *sqes = nullptr;
+    std::size_t sqes_size = 0;
+
+    std::uint32_t *sq_head = nullptr;
+    std::uint32_t *sq_tail = nullptr;
+    std::uint32_t *sq_array = nullptr;
+    std::uint32_t sq_mask = 0;
+    std::uint32_t sq_entries = 0;
+    std::uint32_t sq_local_tail = 0;
+    std::uint32_t sq_submitted_tail = 0;
+
+    std::uint32_t *cq_head = nullptr;
+    std::uint32_t *cq_tail = nullptr;
+    std::uint32_t cq_mask = 0;
+    io_uring_cqe *cqes = nullptr;
+
+    __kernel_timespec timeout_spec{};
+};
+
+} // namespace uring
+} // namespace rotor
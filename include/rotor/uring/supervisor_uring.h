@@ -0,0 +1,75 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/supervisor.h"
+#include "rotor/uring/export.h"
+#include "rotor/uring/system_context_uring.h"
+
+namespace rotor {
+namespace uring {
+
+/** \struct supervisor_uring_t
+ *  \brief delivers rotor-messages on top of io_uring submission/completion loop
+ *
+ * Besides message delivery and timers, the supervisor provides asynchronous
+ * I/O operations for its actors. An operation completion is delivered to the
+ * specified address as {@link message::io_completion_t}. The buffers (and file
+ * descriptors) should remain valid until the completion arrives.
+ *
+ * All supervisors of the same {@link system_context_uring_t} are executed on
+ * the loop thread, i.e. the operations should be started from there.
+ *
+ */
+struct ROTOR_URING_API supervisor_uring_t : public supervisor_t {
+    /** \brief constructs new io_uring supervisor */
+    inline supervisor_uring_t(supervisor_config_t &cfg) : supervisor_t{cfg} {}
+
+    void start() noexcept override;
+    void shutdown() noexcept override;
+    void enqueue(message_ptr_t message) noexcept override;
+    void enqueue_batch(message_base_t *first) noexcept override;
+    void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
+
+    /** \brief reads up to `size` bytes into the buffer
+     *
+     * The `offset` is the file position, `-1` means the current position (or
+     * for non-seekable files, e.g. sockets and pipes). The result is the amount
+     * of read bytes.
+     *
+     */
+    io_id_t read(const address_ptr_t &destination, int fd, void *buffer, std::uint32_t size,
+                 std::uint64_t offset = static_cast<std::uint64_t>(-1)) noexcept;
+
+    /** \brief writes up to `size` bytes from the buffer, see `read` for the `offset` meaning
+     *
+     * The result is the amount of written bytes.
+     *
+     */
+    io_id_t write(const address_ptr_t &destination, int fd, const void *buffer, std::uint32_t size,
+                  std::uint64_t offset = static_cast<std::uint64_t>(-1)) noexcept;
+
+    /** \brief accepts connection on the listening socket, the result is the accepted socket */
+    io_id_t accept(const address_ptr_t &destination, int fd) noexcept;
+
+    /** \brief connects the socket to the address (it is copied) */
+    io_id_t connect(const address_ptr_t &destination, int fd, const sockaddr *address, socklen_t length) noexcept;
+
+    /** \brief cancels in-flight I/O operation; its completion is delivered with `ECANCELED` */
+    void cancel_io(io_id_t id) noexcept;
+
+    /** \brief returns pointer to the io_uring system context */
+    inline system_context_uring_t *get_context() noexcept { return static_cast<system_context_uring_t *>(context); }
+
+  protected:
+    /** \brief notifies the loop about new messages in the inbound queue */
+    void wakeup() noexcept;
+};
+
+} // namespace uring
+} // namespace rotor
@@ -0,0 +1,190 @@
+#pragma once
+
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/arc.hpp"
+#include "rotor/system_context.h"
+#include "rotor/timer_handler.hpp"
+#include "rotor/detail/timer_heap.h"
+#include "rotor/uring/export.h"
+#include "rotor/uring/messages.hpp"
+#include "rotor/uring/ring.h"
+#include <chrono>
+#include <memory>
+#include <sys/socket.h>
+#include <unordered_map>
+
+namespace rotor {
+namespace uring {
+
+struct supervisor_uring_t;
+
+/** \brief intrusive pointer for io_uring supervisor */
+using supervisor_ptr_t = intrusive_ptr_t<supervisor_uring_t>;
+
+/** \struct system_context_uring_t
+ *  \brief The io_uring system context (Linux only)
+ *
+ * The context runs single submission/completion loop, which drives
+ * message processing of the root supervisor, timers, asynchronous I/O
+ * operations and wake-ups from other threads. The latter are done via
+ * `eventfd`, which is read within the ring, i.e. the loop sleeps only
+ * in `io_uring_enter`.
+ *
+ * The completions of I/O operations are delivered as {@link message::io_completion_t}
+ * directly from the loop thread.
+ *
+ */
+struct ROTOR_URING_API system_context_uring_t : public system_context_t {
+    /** \brief constructs io_uring system context
+     *
+     *  \param entries the size of submission queue
+     */
+    explicit system_context_uring_t(std::uint32_t entries = 256) noexcept;
+
+    ~system_context_uring_t();
+
+    /** \brief invokes blocking execution of the supervisor
+     *
+     * It blocks until root supervisor shuts down.
+     *
+     */
+    virtual void run() noexcept;
+
+    /** \brief returns the error of ring or eventfd setup (if any) */
+    inline const std::error_code &get_error() const noexcept { return ec; }
+
+  protected:
+    /** \brief an alias for monotonic clock */
+    using clock_t = std::chrono::steady_clock;
+
+    /** \brief timers ordered by deadline (type) */
+    using timers_t = detail::timer_heap_t<clock_t::time_point>;
+
+    /** \struct io_op_t
+     *  \brief in-flight I/O operation
+     */
+    struct io_op_t {
+        /** \brief operation identity */
+        io_id_t id;
+
+        /** \brief the kind of operation */
+        io_operation_t operation;
+
+        /** \brief the file descriptor of the operation */
+        int fd;
+
+        /** \brief where the completion will be delivered */
+        address_ptr_t destination;
+
+        /** \brief peer address (accept, connect) */
+        sockaddr_storage peer;
+
+        /** \brief peer address length (accept, connect) */
+        socklen_t peer_length;
+    };
+
+    /** \brief unique pointer to in-flight I/O operation */
+    using io_op_ptr_t = std::unique_ptr<io_op_t>;
+
+    /** \brief in-flight I/O operations (type) */
+    using io_ops_t = std::unordered_map<io_id_t, io_op_ptr_t>;
+
+    /** \brief completion user data of the eventfd read */
+    static constexpr std::uint64_t wakeup_tag = 1;
+
+    /** \brief the first user data of I/O operations */
+    static constexpr io_id_t first_io_id = 16;
+
+    /** \brief fires handlers for expired timers */
+    void update_time() noexcept;
+
+    /** \brief start timer implementation */
+    void start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept;
+
+    /** \brief cancel timer implementation */
+    void cancel_timer(timer_handler_base_t &handler) noexcept;
+
+    /** \brief asynchronous read implementation */
+    io_id_t read(const address_ptr_t &destination, int fd, void *buffer, std::uint32_t size,
+                 std::uint64_t offset) noexcept;
+
+    /** \brief asynchronous write implementation */
+    io_id_t write(const address_ptr_t &destination, int fd, const void *buffer, std::uint32_t size,
+                  std::uint64_t offset) noexcept;
+
+    /** \brief asynchronous accept implementation */
+    io_id_t accept(const address_ptr_t &destination, int fd) noexcept;
+
+    /** \brief asynchronous connect implementation */
+    io_id_t connect(const address_ptr_t &destination, int fd, const sockaddr *address, socklen_t length) noexcept;
+
+    /** \brief registers I/O operation and returns submission queue entry for it (`nullptr` on failure) */
+    io_uring_sqe *start_io(io_op_t *op) noexcept;
+
+    /** \brief delivers the completion of I/O operation and forgets it */
+    void complete(io_id_t id, std::int32_t result) noexcept;
+
+    /** \brief requests cancellation of the in-flight I/O operation */
+    void cancel_io(io_id_t id) noexcept;
+
+    /** \brief returns free submission queue entry, flushing the queue when it is full */
+    io_uring_sqe *acquire_sqe() noexcept;
+
+    /** \brief wakes up the loop from other thread */
+    void wakeup() noexcept;
+
+    /** \brief (re)submits eventfd read; on failure `wakeup_armed` remains `false` and the loop retries */
+    void arm_wakeup() noexcept;
+
+    /** \brief submits the prepared entries and waits for completions or the nearest timer */
+    void wait() noexcept;
+
+    /** \brief handles available completions */
+    void reap() noexcept;
+
+    /** \brief cancels in-flight operations and waits their completions */
+    void cancel_all() noexcept;
+
+    /** \brief the submission/completion queues */
+    ring_t ring;
+
+    /** \brief wake-up notifier */
+    int event_fd = -1;
+
+    /** \brief the buffer for eventfd read */
+    std::uint64_t event_value = 0;
+
+    /** \brief whether eventfd read is in-flight */
+    bool wakeup_armed = false;
+
+    /** \brief whether completions are not delivered any longer */
+    bool stopping = false;
+
+    /** \brief the error of ring or eventfd setup */
+    std::error_code ec;
+
+    /** \brief in-flight I/O operations */
+    io_ops_t ops;
+
+    /** \brief the last I/O operation identity */
+    io_id_t last_io_id = first_io_id;
+
+    /** \brief current time */
+    clock_t::time_point now;
+
+    /** \brief timers ordered by deadline */
+    timers_t timers;
+
+    friend struct supervisor_uring_t;
+};
+
+/** \brief intrusive pointer type for io_uring system context */
+using system_context_ptr_t = rotor::intrusive_ptr_t<system_context_uring_t>;
+
+} // namespace uring
+} // namespace rotor
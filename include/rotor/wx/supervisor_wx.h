@@ -13,7 +13,6 @@
 #include <wx/event.h>
 #include <wx/timer.h>
 #include <memory>
-#include <unordered_map>
 
 namespace rotor {
 namespace wx {
@@ -53,6 +52,7 @@ struct ROTOR_WX_API supervisor_wx_t : public supervisor_t {
     void start() noexcept override;
     void shutdown() noexcept override;
     void enqueue(message_ptr_t message) noexcept override;
+    void enqueue_batch(message_base_t *first) noexcept override;
     // void on_timer_trigger(request_id_t timer_id) noexcept override;
 
     /** \brief returns pointer to the wx system context */
@@ -66,35 +66,39 @@ struct ROTOR_WX_API supervisor_wx_t : public supervisor_t {
         /** \brief alias for intrusive pointer for the supervisor */
         using supervisor_ptr_t = intrusive_ptr_t<supervisor_wx_t>;
 
-        /** \brief non-owning pointer to timer handler */
-        timer_handler_base_t *handler;
-
-        /** \brief intrusive pointer to the supervisor */
-        supervisor_ptr_t sup;
+        /** \brief non-owning pointer to the supervisor */
+        supervisor_wx_t *sup;
 
         /** \brief constructs timer from wx supervisor */
-        timer_t(timer_handler_base_t *handler, supervisor_ptr_t &&sup_);
+        timer_t(supervisor_wx_t *sup_);
 
-        /** \brief invokes `shutdown_timer_trigger` method if shutdown timer triggers*/
+        /** \brief invokes supervisor's `on_timer` method */
         virtual void Notify() noexcept override;
     };
 
     friend struct timer_t;
 
     void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
-    void do_cancel_timer(request_id_t timer_id) noexcept override;
+    void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
+
+    /** \brief schedules inbound queue draining and messages processing in wx event loop (wake-up) */
+    void schedule_process() noexcept;
 
-    /** \brief unique pointer to timer */
-    using timer_ptr_t = std::unique_ptr<timer_t>;
+    /** \brief (re-)arms the native timer to the earliest deadline or stops it if there are no timers
+     *
+     * The supervisor is kept alive (referenced) while the native timer is running.
+     *
+     */
+    void arm_timer() noexcept;
 
-    /** \brief timer id to timer pointer mapping type */
-    using timers_map_t = std::unordered_map<request_id_t, timer_ptr_t>;
+    /** \brief triggers expired timers and processes messages (native timer callback) */
+    void on_timer() noexcept;
 
     /** \brief non-owning pointer to the wx application (copied from config) */
     wxEvtHandler *handler;
 
-    /** \brief timer id to timer pointer mapping */
-    timers_map_t timers_map;
+    /** \brief the single native timer of the supervisor */
+    timer_t timer;
 };
 
 } // namespace wx
@@ -128,7 +128,7 @@ void actor_base_t::shutdown_finish() noexcept {
         cancel_timer(timers_map.begin()->first);
     }
     while (!active_requests.empty()) {
-        supervisor->do_cancel_timer(*active_requests.begin());
+        supervisor->discard_request(active_requests.front());
     }
     /*
     if (!deactivating_plugins.empty()) {
@@ -251,8 +251,9 @@ plugin_base_t *actor_base_t::get_plugin(const std::type_index &identity) const n
 }
 
 void actor_base_t::cancel_timer(request_id_t request_id) noexcept {
-    assert(timers_map.find(request_id) != timers_map.end() && "request does exist");
-    supervisor->do_cancel_timer(request_id);
+    auto it = timers_map.find(request_id);
+    assert(it != timers_map.end() && "request does exist");
+    supervisor->do_cancel_timer(*it->second);
 }
 
 void actor_base_t::on_timer_trigger(request_id_t request_id, bool cancelled) noexcept {
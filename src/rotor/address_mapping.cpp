@@ -13,16 +13,21 @@ using namespace rotor;
 void address_mapping_t::set(actor_base_t &actor, const subscription_info_ptr_t &info) noexcept {
     auto &point_map = actor_map[static_cast<const void *>(&actor)];
     auto message_type = info->handler->message_type();
-    point_map.try_emplace(message_type, info);
+    for (auto &it : point_map) {
+        if (it.first == message_type) {
+            return;
+        }
+    }
+    point_map.emplace_back(message_type, info);
 }
 
 address_ptr_t address_mapping_t::get_mapped_address(actor_base_t &actor, const void *message) noexcept {
     auto a_it = actor_map.find(static_cast<const void *>(&actor));
     if (a_it != actor_map.end()) {
-        auto &point_map = a_it->second;
-        auto p_it = point_map.find(message);
-        if (p_it != point_map.end()) {
-            return p_it->second->address;
+        for (auto &it : a_it->second) {
+            if (it.first == message) {
+                return it.second->address;
+            }
         }
     }
     return {};
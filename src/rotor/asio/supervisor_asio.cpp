@@ -10,24 +10,8 @@
 using namespace rotor::asio;
 using namespace rotor;
 
-namespace rotor::asio {
-namespace {
-namespace to {
-struct on_timer_trigger {};
-} // namespace to
-} // namespace
-} // namespace rotor::asio
-
-namespace rotor {
-template <>
-inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool>(request_id_t request_id,
-                                                                                  bool cancelled) noexcept {
-    on_timer_trigger(request_id, cancelled);
-}
-} // namespace rotor
-
 supervisor_asio_t::supervisor_asio_t(supervisor_config_asio_t &config_)
-    : supervisor_t{config_}, strand{config_.strand} {
+    : supervisor_t{config_}, strand{config_.strand}, timer{config_.strand->context()} {
     if (config_.guard_context) {
         guard = std::make_unique<guard_t>(asio::make_work_guard(strand->context()));
     }
@@ -40,47 +24,63 @@ void supervisor_asio_t::start() noexcept { create_forwarder (&supervisor_asio_t:
 void supervisor_asio_t::shutdown() noexcept { create_forwarder (&supervisor_asio_t::invoke_shutdown)(); }
 
 void supervisor_asio_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
-    auto timer = std::make_unique<supervisor_asio_t::timer_t>(&handler, strand->context());
-    timer->expires_from_now(interval);
+    if (queue_timer(interval, handler)) {
+        arm_timer();
+    }
+}
 
-    intrusive_ptr_t<supervisor_asio_t> self(this);
-    request_id_t timer_id = handler.request_id;
-    timer->async_wait([self = self, timer_id = timer_id](const boost::system::error_code &ec) {
-        auto &strand = self->get_strand();
-        if (!ec) {
-            asio::defer(strand, [self = self, timer_id = timer_id]() {
-                auto &sup = *self;
-                auto &timers_map = sup.timers_map;
-                auto it = timers_map.find(timer_id);
-                if (it != timers_map.end()) {
-                    auto actor_ptr = it->second->handler->owner;
-                    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
-                    timers_map.erase(timer_id);
-                    sup.do_process();
-                }
-            });
-        }
-    });
-    timers_map.emplace(timer_id, std::move(timer));
+void supervisor_asio_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    if (unqueue_timer(handler)) {
+        arm_timer();
+    }
 }
 
-void supervisor_asio_t::do_cancel_timer(request_id_t timer_id) noexcept {
-    auto &timer = timers_map.at(timer_id);
+void supervisor_asio_t::arm_timer() noexcept {
     boost::system::error_code ec;
-    timer->cancel(ec);
+    if (timers_queue.empty()) {
+        timer.cancel(ec);
+        return;
+    }
+    timer.expires_at(get_timers_deadline(), ec);
 
-    auto &actor_ptr = timer->handler->owner;
-    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-    timers_map.erase(timer_id);
+    intrusive_ptr_t<supervisor_asio_t> self(this);
+    timer.async_wait([self = std::move(self)](const boost::system::error_code &ec) mutable {
+        if (!ec) {
+            auto &strand = self->get_strand();
+            asio::defer(strand, [self = std::move(self)]() { self->on_timer(); });
+        }
+    });
     // ignore the possible error, caused the case when timer is not cancelleable
     // if (ec) { ... }
 }
 
+void supervisor_asio_t::on_timer() noexcept {
+    auto triggered = trigger_timers(timer_clock_t::now());
+    arm_timer();
+    if (triggered) {
+        do_process();
+    }
+}
+
 void supervisor_asio_t::enqueue(rotor::message_ptr_t message) noexcept {
+    message->share();
     auto leader = static_cast<supervisor_asio_t *>(locality_leader);
     auto &inbound = leader->inbound_queue;
     inbound.push(message.detach());
+    if (leader->request_wakeup()) {
+        schedule_process();
+    }
+}
+
+void supervisor_asio_t::enqueue_batch(message_base_t *first) noexcept {
+    auto leader = static_cast<supervisor_asio_t *>(locality_leader);
+    leader->inbound_queue.push_batch(first);
+    if (leader->request_wakeup()) {
+        schedule_process();
+    }
+}
 
+void supervisor_asio_t::schedule_process() noexcept {
     auto actor_ptr = supervisor_ptr_t(this);
     asio::defer(get_strand(), [actor = std::move(actor_ptr)]() mutable {
         auto &sup = *actor;
@@ -108,10 +108,8 @@ void supervisor_asio_t::do_process() noexcept {
     auto &inbound = leader->inbound_queue;
     auto &queue = leader->queue;
     auto enqueued_messages = size_t{0};
-    message_base_t *ptr;
-    while (inbound.pop(ptr)) {
-        queue.emplace_back(ptr, false);
-    }
+    leader->clear_wakeup();
+    inbound.drain(queue);
     if (!queue.empty()) {
         enqueued_messages = supervisor_t::do_process();
     }
@@ -119,10 +117,7 @@ void supervisor_asio_t::do_process() noexcept {
     if (enqueued_messages) {
         auto deadline = clock_t::now() + time_units_t{poll_duration.total_microseconds()};
         while (clock_t::now() < deadline && queue.empty()) {
-            message_base_t *ptr;
-            while (inbound.pop(ptr)) {
-                queue.emplace_back(ptr, false);
-            }
+            inbound.drain(queue);
         }
         if (!queue.empty()) {
             supervisor_t::do_process();
@@ -0,0 +1,233 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/epoll/supervisor_epoll.h"
+#include <cerrno>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+using namespace rotor;
+using namespace rotor::epoll;
+
+namespace {
+inline void drain_fd(int fd) noexcept {
+    std::uint64_t value;
+    auto r = ::read(fd, &value, sizeof(value));
+    (void)r;
+}
+} // namespace
+
+void supervisor_epoll_t::async_cb(watcher_t &watcher, std::uint32_t) noexcept {
+    static_cast<supervisor_epoll_t *>(watcher.data)->on_async();
+}
+
+void supervisor_epoll_t::timer_cb(watcher_t &watcher, std::uint32_t) noexcept {
+    static_cast<supervisor_epoll_t *>(watcher.data)->on_timer();
+}
+
+void supervisor_epoll_t::fd_cb(watcher_t &watcher, std::uint32_t events) noexcept {
+    static_cast<supervisor_epoll_t *>(watcher.data)->on_fd(static_cast<fd_watcher_t &>(watcher), events);
+}
+
+supervisor_epoll_t::supervisor_epoll_t(supervisor_config_t &config_)
+    : supervisor_t{config_}, async_watcher{&async_cb, this}, timer_watcher{&timer_cb, this} {
+    event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+}
+
+supervisor_epoll_t::~supervisor_epoll_t() {
+    if (event_fd >= 0) {
+        close(event_fd);
+    }
+    if (timer_fd >= 0) {
+        close(timer_fd);
+    }
+}
+
+void supervisor_epoll_t::do_initialize(system_context_t *ctx) noexcept {
+    auto epoll_ctx = static_cast<system_context_epoll_t *>(ctx);
+    auto ec = std::error_code{};
+    if (event_fd < 0 || timer_fd < 0) {
+        ec = std::error_code(errno, std::system_category());
+    } else if (!epoll_ctx->get_error()) {
+        ec = epoll_ctx->add(event_fd, EPOLLIN, async_watcher);
+        if (!ec) {
+            ec = epoll_ctx->add(timer_fd, EPOLLIN, timer_watcher);
+        }
+    }
+    registered = !ec;
+    supervisor_t::do_initialize(ctx);
+    if (ec) {
+        ctx->on_error(this, make_error(ec));
+    }
+}
+
+void supervisor_epoll_t::enqueue(rotor::message_ptr_t message) noexcept {
+    message->share();
+    auto leader = static_cast<supervisor_epoll_t *>(locality_leader);
+    leader->inbound_queue.push(message.detach());
+    if (leader->request_wakeup()) {
+        wakeup();
+    }
+}
+
+void supervisor_epoll_t::enqueue_batch(message_base_t *first) noexcept {
+    auto leader = static_cast<supervisor_epoll_t *>(locality_leader);
+    leader->inbound_queue.push_batch(first);
+    if (leader->request_wakeup()) {
+        wakeup();
+    }
+}
+
+void supervisor_epoll_t::wakeup() noexcept {
+    std::uint64_t value = 1;
+    auto r = ::write(event_fd, &value, sizeof(value));
+    (void)r;
+}
+
+void supervisor_epoll_t::start() noexcept { wakeup(); }
+
+void supervisor_epoll_t::shutdown_finish() noexcept {
+    supervisor_t::shutdown_finish();
+    if (registered) {
+        auto ctx = get_context();
+        ctx->remove(event_fd, async_watcher);
+        ctx->remove(timer_fd, timer_watcher);
+        for (auto &it : fd_watchers) {
+            ctx->remove(it.first, *it.second);
+        }
+        registered = false;
+    }
+    fd_watchers.clear();
+    move_inbound_queue();
+}
+
+void supervisor_epoll_t::shutdown() noexcept {
+    auto &sup_addr = supervisor->get_address();
+    auto ec = make_error_code(shutdown_code_t::normal);
+    auto reason = make_error(ec);
+    supervisor->enqueue(make_message<rotor::payload::shutdown_trigger_t>(sup_addr, address, reason));
+}
+
+void supervisor_epoll_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
+    if (queue_timer(interval, handler)) {
+        arm_timer();
+    }
+}
+
+void supervisor_epoll_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    if (unqueue_timer(handler)) {
+        arm_timer();
+    }
+}
+
+void supervisor_epoll_t::arm_timer() noexcept {
+    itimerspec spec{};
+    if (timers_queue.empty()) {
+        if (timer_armed) {
+            timerfd_settime(timer_fd, 0, &spec, nullptr);
+            timer_armed = false;
+            intrusive_ptr_release(this);
+        }
+        return;
+    }
+
+    // steady clock is CLOCK_MONOTONIC
+    using namespace std::chrono;
+    auto deadline = duration_cast<nanoseconds>(get_timers_deadline().time_since_epoch()).count();
+    spec.it_value.tv_sec = static_cast<time_t>(deadline / 1000000000);
+    spec.it_value.tv_nsec = static_cast<long>(deadline % 1000000000);
+    if (!spec.it_value.tv_sec && !spec.it_value.tv_nsec) {
+        spec.it_value.tv_nsec = 1;
+    }
+    timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+    if (!timer_armed) {
+        timer_armed = true;
+        intrusive_ptr_add_ref(this);
+    }
+}
+
+void supervisor_epoll_t::on_timer() noexcept {
+    drain_fd(timer_fd);
+    if (!timer_armed) {
+        return;
+    }
+    // adopt the reference, held by the (now inactive) native timer
+    auto self = intrusive_ptr_t<supervisor_epoll_t>(this, false);
+    timer_armed = false;
+    auto triggered = trigger_timers(timer_clock_t::now());
+    if (!timers_queue.empty()) {
+        arm_timer();
+    }
+    if (triggered) {
+        do_process();
+    }
+}
+
+void supervisor_epoll_t::on_fd(fd_watcher_t &watcher, std::uint32_t events) noexcept {
+    // one-shot watch is disarmed by the kernel
+    put(make_message<payload::fd_ready_t>(watcher.destination, watcher.fd, events));
+    do_process();
+}
+
+void supervisor_epoll_t::on_async() noexcept {
+    drain_fd(event_fd);
+    auto leader = static_cast<supervisor_epoll_t *>(locality_leader);
+    leader->clear_wakeup();
+    move_inbound_queue();
+    auto &queue = leader->queue;
+    auto enqueued_messages = size_t{0};
+    if (!queue.empty()) {
+        enqueued_messages = do_process();
+    }
+
+    if (enqueued_messages) {
+        auto deadline = timer_clock_t::now() + std::chrono::microseconds{poll_duration.total_microseconds()};
+        while (timer_clock_t::now() < deadline && queue.empty()) {
+            move_inbound_queue();
+        }
+
+        if (!queue.empty()) {
+            do_process();
+        }
+    }
+}
+
+std::error_code supervisor_epoll_t::watch_fd(const address_ptr_t &destination, int fd, std::uint32_t events) noexcept {
+    if (fd_watchers.count(fd)) {
+        return std::make_error_code(std::errc::file_exists);
+    }
+    auto watcher = fd_watcher_ptr_t(new fd_watcher_t{{&fd_cb, this}, fd, events, destination});
+    auto ec = get_context()->add(fd, events | EPOLLONESHOT, *watcher);
+    if (!ec) {
+        fd_watchers.emplace(fd, std::move(watcher));
+    }
+    return ec;
+}
+
+std::error_code supervisor_epoll_t::rearm_fd(int fd) noexcept {
+    auto it = fd_watchers.find(fd);
+    if (it == fd_watchers.end()) {
+        return std::make_error_code(std::errc::no_such_file_or_directory);
+    }
+    auto &watcher = *it->second;
+    return get_context()->modify(fd, watcher.events | EPOLLONESHOT, watcher);
+}
+
+void supervisor_epoll_t::unwatch_fd(int fd) noexcept {
+    auto it = fd_watchers.find(fd);
+    if (it == fd_watchers.end()) {
+        return;
+    }
+    get_context()->remove(fd, *it->second);
+    fd_watchers.erase(it);
+}
+
+void supervisor_epoll_t::move_inbound_queue() noexcept {
+    auto leader = static_cast<supervisor_epoll_t *>(locality_leader);
+    leader->inbound_queue.drain(leader->queue);
+}
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/epoll/system_context_epoll.h"
+#include "rotor/supervisor.h"
+#include <cerrno>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace rotor {
+using namespace rotor::epoll;
+
+namespace {
+namespace to {
+struct state {};
+} // namespace to
+} // namespace
+
+template <> auto &supervisor_t::access<to::state>() noexcept { return state; }
+
+system_context_epoll_t::system_context_epoll_t() noexcept {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        ec = std::error_code(errno, std::system_category());
+    }
+}
+
+system_context_epoll_t::~system_context_epoll_t() {
+    if (epoll_fd >= 0) {
+        close(epoll_fd);
+    }
+}
+
+void system_context_epoll_t::run() noexcept {
+    auto &root_sup = *get_supervisor();
+    if (ec) {
+        on_error(&root_sup, make_error(identity(), ec));
+        return;
+    }
+    auto condition = [&]() -> bool { return root_sup.access<to::state>() != state_t::SHUT_DOWN; };
+
+    epoll_event events[max_events];
+    dispatched = events;
+    while (condition()) {
+        auto count = epoll_wait(epoll_fd, events, max_events, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            on_error(&root_sup, make_error(identity(), std::error_code(errno, std::system_category())));
+            return;
+        }
+        dispatched_count = count;
+        for (dispatched_index = 0; dispatched_index < count; ++dispatched_index) {
+            auto watcher = static_cast<watcher_t *>(events[dispatched_index].data.ptr);
+            if (watcher) {
+                watcher->callback(*watcher, events[dispatched_index].events);
+            }
+        }
+        dispatched_count = 0;
+    }
+    dispatched = nullptr;
+}
+
+std::error_code system_context_epoll_t::add(int fd, std::uint32_t events, watcher_t &watcher) noexcept {
+    epoll_event event{};
+    event.events = events;
+    event.data.ptr = &watcher;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        return std::error_code(errno, std::system_category());
+    }
+    return {};
+}
+
+std::error_code system_context_epoll_t::modify(int fd, std::uint32_t events, watcher_t &watcher) noexcept {
+    epoll_event event{};
+    event.events = events;
+    event.data.ptr = &watcher;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event) < 0) {
+        return std::error_code(errno, std::system_category());
+    }
+    return {};
+}
+
+void system_context_epoll_t::remove(int fd, watcher_t &watcher) noexcept {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    // the watcher might be destroyed, forget its not yet dispatched events
+    for (auto i = dispatched_index + 1; i < dispatched_count; ++i) {
+        if (dispatched[i].data.ptr == &watcher) {
+            dispatched[i].data.ptr = nullptr;
+        }
+    }
+}
+
+} // namespace rotor
@@ -9,26 +9,6 @@
 using namespace rotor;
 using namespace rotor::ev;
 
-namespace rotor::ev {
-namespace {
-namespace to {
-struct on_timer_trigger {};
-struct timers_map {};
-} // namespace to
-} // namespace
-} // namespace rotor::ev
-
-namespace rotor {
-template <>
-inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool>(request_id_t request_id,
-                                                                                  bool cancelled) noexcept {
-    on_timer_trigger(request_id, cancelled);
-}
-
-template <> inline auto &rotor::ev::supervisor_ev_t::access<to::timers_map>() noexcept { return timers_map; }
-
-} // namespace rotor
-
 void supervisor_ev_t::async_cb(struct ev_loop *, ev_async *w, int revents) noexcept {
     assert(revents & EV_ASYNC);
     (void)revents;
@@ -36,29 +16,19 @@ void supervisor_ev_t::async_cb(struct ev_loop *, ev_async *w, int revents) noexc
     sup->on_async();
 }
 
-static void timer_cb(struct ev_loop *, ev_timer *w, int revents) noexcept {
+void supervisor_ev_t::timer_cb(struct ev_loop *, ev_timer *w, int revents) noexcept {
     assert(revents & EV_TIMER);
     (void)revents;
     auto *sup = static_cast<supervisor_ev_t *>(w->data);
-    auto timer = static_cast<supervisor_ev_t::timer_t *>(w);
-    auto timer_id = timer->handler->request_id;
-    auto &timers_map = sup->access<to::timers_map>();
-
-    try {
-        auto actor_ptr = timers_map.at(timer_id)->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
-        timers_map.erase(timer_id);
-        sup->do_process();
-    } catch (std::out_of_range &ex) {
-        // no-op
-    }
-    intrusive_ptr_release(sup);
+    sup->on_timer();
 }
 
 supervisor_ev_t::supervisor_ev_t(supervisor_config_ev_t &config_)
     : supervisor_t{config_}, loop{config_.loop}, loop_ownership{config_.loop_ownership},
       poll_duration{static_cast<ev_tstamp>(supervisor_t::poll_duration.total_nanoseconds()) / 1000000000} {
     ev_async_init(&async_watcher, async_cb);
+    ev_init(&timer_watcher, timer_cb);
+    timer_watcher.data = this;
 }
 
 void supervisor_ev_t::do_initialize(system_context_t *ctx) noexcept {
@@ -68,10 +38,21 @@ void supervisor_ev_t::do_initialize(system_context_t *ctx) noexcept {
 }
 
 void supervisor_ev_t::enqueue(rotor::message_ptr_t message) noexcept {
+    message->share();
     auto leader = static_cast<supervisor_ev_t *>(locality_leader);
     auto &inbound = leader->inbound_queue;
     inbound.push(message.detach());
-    ev_async_send(loop, &async_watcher);
+    if (leader->request_wakeup()) {
+        ev_async_send(loop, &async_watcher);
+    }
+}
+
+void supervisor_ev_t::enqueue_batch(message_base_t *first) noexcept {
+    auto leader = static_cast<supervisor_ev_t *>(locality_leader);
+    leader->inbound_queue.push_batch(first);
+    if (leader->request_wakeup()) {
+        ev_async_send(loop, &async_watcher);
+    }
 }
 
 void supervisor_ev_t::start() noexcept { ev_async_send(loop, &async_watcher); }
@@ -90,34 +71,52 @@ void supervisor_ev_t::shutdown() noexcept {
 }
 
 void supervisor_ev_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
-    auto timer = std::make_unique<timer_t>();
-    auto timer_ptr = timer.get();
-    ev_tstamp ev_timeout = static_cast<ev_tstamp>(interval.total_nanoseconds()) / 1000000000;
-    ev_timer_init(timer_ptr, timer_cb, ev_timeout, 0);
-    timer_ptr->handler = &handler;
-    timer_ptr->data = this;
-
-    ev_timer_start(loop, timer_ptr);
-    intrusive_ptr_add_ref(this);
-    timers_map.emplace(handler.request_id, std::move(timer));
+    if (queue_timer(interval, handler)) {
+        arm_timer();
+    }
+}
+
+void supervisor_ev_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    if (unqueue_timer(handler)) {
+        arm_timer();
+    }
 }
 
-void supervisor_ev_t::do_cancel_timer(request_id_t timer_id) noexcept {
-    try {
-        auto &timer = timers_map.at(timer_id);
-        ev_timer_stop(loop, timer.get());
-        auto actor_ptr = timer->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-        timers_map.erase(timer_id);
-        intrusive_ptr_release(this);
-    } catch (std::out_of_range &ex) {
-        // no-op
+void supervisor_ev_t::arm_timer() noexcept {
+    auto active = ev_is_active(&timer_watcher);
+    if (active) {
+        ev_timer_stop(loop, &timer_watcher);
+    }
+    if (timers_queue.empty()) {
+        if (active) {
+            intrusive_ptr_release(this);
+        }
+        return;
+    }
+
+    using seconds_t = std::chrono::duration<ev_tstamp>;
+    auto delay = std::chrono::duration_cast<seconds_t>(get_timers_deadline() - timer_clock_t::now()).count();
+    ev_timer_set(&timer_watcher, delay > 0 ? delay : 0., 0.);
+    ev_timer_start(loop, &timer_watcher);
+    if (!active) {
+        intrusive_ptr_add_ref(this);
+    }
+}
+
+void supervisor_ev_t::on_timer() noexcept {
+    // adopt the reference, held by the (now inactive) native timer
+    auto self = intrusive_ptr_t<supervisor_ev_t>(this, false);
+    auto triggered = trigger_timers(timer_clock_t::now());
+    arm_timer();
+    if (triggered) {
+        do_process();
     }
 }
 
 void supervisor_ev_t::on_async() noexcept {
-    move_inbound_queue();
     auto leader = static_cast<supervisor_ev_t *>(locality_leader);
+    leader->clear_wakeup();
+    move_inbound_queue();
     auto &queue = leader->queue;
     auto enqueued_messages = size_t{0};
     if (!queue.empty()) {
@@ -148,10 +147,5 @@ supervisor_ev_t::~supervisor_ev_t() {
 
 void supervisor_ev_t::move_inbound_queue() noexcept {
     auto leader = static_cast<supervisor_ev_t *>(locality_leader);
-    auto &inbound = leader->inbound_queue;
-    auto &queue = leader->queue;
-    message_base_t *ptr;
-    while (inbound.pop(ptr)) {
-        queue.emplace_back(ptr, false);
-    }
+    leader->inbound_queue.drain(leader->queue);
 }
@@ -31,8 +31,8 @@ struct continuation_impl_t final : continuation_t {
     message_ptr_t &message;
 };
 
-handler_base_t::handler_base_t(actor_base_t &actor, const void *handler_type_) noexcept
-    : handler_type{handler_type_}, actor_ptr{&actor} {
+handler_base_t::handler_base_t(actor_base_t &actor, const void *handler_type_, handler_thunk_t thunk_) noexcept
+    : handler_type{handler_type_}, actor_ptr{&actor}, thunk{thunk_} {
     auto h1 = reinterpret_cast<std::size_t>(handler_type);
     auto h2 = reinterpret_cast<std::size_t>(&actor);
     precalc_hash = h1 ^ (h2 << 1);
@@ -41,6 +41,8 @@ handler_base_t::handler_base_t(actor_base_t &actor, const void *handler_type_) n
 
 handler_base_t::~handler_base_t() { intrusive_ptr_release(actor_ptr); }
 
+void handler_base_t::virtual_call(handler_base_t &self, message_ptr_t &message) noexcept { self.call(message); }
+
 handler_ptr_t handler_base_t::upgrade(const void *tag) noexcept {
     handler_ptr_t self(this);
     return handler_ptr_t(new handler_intercepted_t(self, tag));
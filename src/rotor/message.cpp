@@ -1,21 +1,33 @@
 #include "rotor/message.h"
+#include <deque>
 #include <unordered_map>
 
-using type_map_t = std::unordered_map<std::string_view, const void *>;
+using namespace rotor::message_support;
+
+namespace {
+/* the same message type might be instantiated in different shared libraries,
+ * so types are matched by names; the lookup is performed only once per type
+ * during static initialization */
+struct types_registry_t {
+    std::unordered_map<std::string_view, const registered_type_t *> map;
+    std::deque<registered_type_t> types;
+};
+} // namespace
 
 namespace rotor::message_support {
 
 const void *register_type(const std::type_index &type_index) noexcept {
-    static type_map_t type_map = {};
+    static types_registry_t registry = {};
 
     auto name = std::string_view(type_index.name());
-    auto it = type_map.find(name);
-    if (it != type_map.end()) {
+    auto it = registry.map.find(name);
+    if (it != registry.map.end()) {
         return it->second;
     }
-    auto ptr = static_cast<const void *>(type_index.name());
-    type_map[name] = ptr;
-    return ptr;
+    auto id = static_cast<std::uint32_t>(registry.types.size());
+    auto &type = registry.types.emplace_back(registered_type_t{type_index.name(), id});
+    registry.map[name] = &type;
+    return &type;
 }
 
 } // namespace rotor::message_support
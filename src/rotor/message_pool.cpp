@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/message_pool.h"
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+using namespace rotor;
+
+struct alignas(std::max_align_t) message_pool_t::block_t {
+    union {
+        message_pool_t *pool; /* when allocated */
+        block_t *next;        /* when cached */
+    };
+    std::size_t size_class;
+};
+
+namespace {
+
+template <typename T> inline T *closed_marker() noexcept { return reinterpret_cast<T *>(std::uintptr_t{1}); }
+
+inline std::size_t size_class_of(std::size_t size) noexcept {
+    auto block_size = message_pool_t::min_block_size;
+    std::size_t r = 0;
+    while (r < message_pool_t::size_classes && block_size < size) {
+        block_size <<= 1;
+        ++r;
+    }
+    return r;
+}
+
+} // namespace
+
+namespace rotor::message_support {
+
+message_pool_t *&current_pool() noexcept {
+    thread_local message_pool_t *pool = nullptr;
+    return pool;
+}
+
+} // namespace rotor::message_support
+
+message_pool_t::message_pool_t(std::size_t capacity_) noexcept
+    : free_lists{nullptr}, free_counts{0}, capacity{capacity_}, returned{nullptr}, orphans{0} {}
+
+message_pool_t::~message_pool_t() {}
+
+void *message_pool_t::allocate(message_pool_t *pool, std::size_t size) {
+    if (pool) {
+        return pool->allocate_block(size);
+    }
+    auto block = static_cast<block_t *>(::operator new(sizeof(block_t) + size));
+    block->pool = nullptr;
+    block->size_class = size_classes;
+    return block + 1;
+}
+
+void message_pool_t::deallocate(void *ptr) noexcept {
+    auto block = static_cast<block_t *>(ptr) - 1;
+    auto pool = block->pool;
+    if (!pool) {
+        ::operator delete(block);
+    } else {
+        pool->release(block);
+    }
+}
+
+void *message_pool_t::allocate_block(std::size_t size) {
+    auto size_class = size_class_of(size);
+    if (size_class == size_classes) {
+        ++misses_count;
+        return allocate(nullptr, size);
+    }
+
+    if (!free_lists[size_class]) {
+        reclaim();
+    }
+
+    block_t *block = free_lists[size_class];
+    if (block) {
+        free_lists[size_class] = block->next;
+        --free_counts[size_class];
+        ++hits_count;
+    } else {
+        auto block_size = min_block_size << size_class;
+        block = static_cast<block_t *>(::operator new(sizeof(block_t) + block_size));
+        block->size_class = size_class;
+        ++misses_count;
+    }
+    block->pool = this;
+    ++live;
+    return block + 1;
+}
+
+void message_pool_t::release(block_t *block) noexcept {
+    if (message_support::current_pool() == this) {
+        --live;
+        recycle(block);
+        return;
+    }
+
+    auto head = returned.load(std::memory_order_relaxed);
+    do {
+        if (head == closed_marker<block_t>()) {
+            ::operator delete(block);
+            if (orphans.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete this;
+            }
+            return;
+        }
+        block->next = head;
+    } while (!returned.compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void message_pool_t::recycle(block_t *block) noexcept {
+    auto size_class = block->size_class;
+    if (free_counts[size_class] < capacity) {
+        block->next = free_lists[size_class];
+        free_lists[size_class] = block;
+        ++free_counts[size_class];
+    } else {
+        ::operator delete(block);
+    }
+}
+
+void message_pool_t::reclaim() noexcept {
+    auto block = returned.exchange(nullptr, std::memory_order_acquire);
+    while (block) {
+        auto next = block->next;
+        --live;
+        recycle(block);
+        block = next;
+    }
+}
+
+void message_pool_t::close() noexcept {
+    assert(message_support::current_pool() != this && "pool cannot be closed in own context");
+    auto block = returned.exchange(closed_marker<block_t>(), std::memory_order_acq_rel);
+    while (block) {
+        auto next = block->next;
+        --live;
+        ::operator delete(block);
+        block = next;
+    }
+    for (std::size_t i = 0; i < size_classes; ++i) {
+        block = free_lists[i];
+        while (block) {
+            auto next = block->next;
+            ::operator delete(block);
+            block = next;
+        }
+    }
+
+    if (!live) {
+        delete this;
+    } else {
+        auto outstanding = static_cast<std::ptrdiff_t>(live);
+        if (orphans.fetch_add(outstanding, std::memory_order_acq_rel) + outstanding == 0) {
+            delete this;
+        }
+    }
+}
@@ -22,13 +22,13 @@ struct lifetime {};
 struct manager {};
 struct parent {};
 struct policy {};
+struct request_map {};
 struct shutdown_timeout {};
 struct spawner_address {};
 struct state {};
 struct shutdown_reason {};
 struct system_context {};
 struct synchronize_start {};
-struct timers_map {};
 struct assign_shutdown_reason {};
 } // namespace to
 } // namespace
@@ -45,13 +45,13 @@ template <> auto &actor_base_t::access<to::lifetime>() noexcept { return lifetim
 template <> auto &supervisor_t::access<to::manager>() noexcept { return manager; }
 template <> auto &supervisor_t::access<to::parent>() noexcept { return parent; }
 template <> auto &supervisor_t::access<to::policy>() noexcept { return policy; }
+template <> auto &supervisor_t::access<to::request_map>() noexcept { return request_map; }
 template <> auto &actor_base_t::access<to::shutdown_timeout>() noexcept { return shutdown_timeout; }
 template <> auto &actor_base_t::access<to::spawner_address>() noexcept { return spawner_address; }
 template <> auto &actor_base_t::access<to::state>() noexcept { return state; }
 template <> auto &actor_base_t::access<to::shutdown_reason>() noexcept { return shutdown_reason; }
 template <> auto &supervisor_t::access<to::system_context>() noexcept { return context; }
 template <> auto &supervisor_t::access<to::synchronize_start>() noexcept { return synchronize_start; }
-template <> auto &supervisor_t::access<to::timers_map>() noexcept { return timers_map; }
 
 template <>
 auto actor_base_t::access<to::assign_shutdown_reason, const extended_error_ptr_t &>(
@@ -78,6 +78,7 @@ void child_manager_plugin_t::activate(actor_base_t *actor_) noexcept {
     auto address = actor->get_address();
     auto info = detail::child_info_ptr_t{};
     info = new detail::child_info_t(address, factory_t{}, actor);
+    track(*info, 1);
     actors_map.emplace(address, std::move(info));
     actor->configure(*this);
 }
@@ -96,6 +97,8 @@ void child_manager_plugin_t::remove_child(const actor_base_t &child) noexcept {
     assert(it_actor != actors_map.end());
     auto info_ptr = it_actor->second;
     auto &info = *info_ptr;
+    track(info, -1);
+    initializing_actors.erase(child.get_address());
     bool child_started = info.started;
     auto &state = actor->access<to::state>();
     auto sup = static_cast<supervisor_t *>(actor);
@@ -146,6 +149,7 @@ void child_manager_plugin_t::remove_child(const actor_base_t &child) noexcept {
                     auto request_id = sup->start_timer(info.restart_period, *this, callback);
                     info.timer_id = request_id;
                     spawning_map[request_id] = std::move(info_ptr);
+                    shutdown_unrequested = true;
                     erase_spawner = false;
                 }
             },
@@ -155,6 +159,8 @@ void child_manager_plugin_t::remove_child(const actor_base_t &child) noexcept {
     info.actor.reset();
     if (erase_spawner) {
         actors_map.erase(it_actor);
+    } else {
+        track(info, 1);
     }
 
     if (state == state_t::SHUTTING_DOWN && (active_actors() <= 1)) {
@@ -186,14 +192,19 @@ void child_manager_plugin_t::create_child(const actor_ptr_t &child) noexcept {
         auto it = actors_map.find(spawner_address);
         auto info = std::move(it->second);
         actors_map.erase(it);
+        track(*info, -1);
         info->actor = child;
         spawner_address = info->address = address;
+        track(*info, 1);
         actors_map.emplace(address, std::move(info));
     } else {
         auto info = detail::child_info_ptr_t{};
         info = new detail::child_info_t(address, factory_t{}, child);
+        track(*info, 1);
         actors_map.emplace(address, std::move(info));
     }
+    initializing_actors.emplace(address);
+    shutdown_unrequested = true;
     sup.access<to::alive_actors>().emplace(child.get());
     if (static_cast<actor_base_t &>(sup).access<to::state>() == state_t::INITIALIZING) {
         reaction_on(reaction_t::INIT);
@@ -218,13 +229,16 @@ void child_manager_plugin_t::on_spawn(message::spawn_actor_t &message) noexcept
     if (!info.active) {
         return;
     }
+    track(info, -1);
     info.spawn_attempt();
+    track(info, 1);
 
     try {
         auto child = info.factory(sup, addr);
         assert(child->access<to::spawner_address>() && "spawner address is not defined");
         info.actor = child;
     } catch (...) {
+        track(info, -1);
         bool try_next = (info.policy == restart_policy_t::always) || (info.policy == restart_policy_t::fail_only);
         auto state = actor->access<to::state>();
         if (state == state_t::INITIALIZING) {
@@ -247,9 +261,11 @@ void child_manager_plugin_t::on_spawn(message::spawn_actor_t &message) noexcept
             auto request_id = sup.start_timer(info.restart_period, *this, callback);
             info.timer_id = request_id;
             spawning_map[request_id] = it->second;
+            shutdown_unrequested = true;
         } else {
             info.active = false;
         }
+        track(info, 1);
     }
 }
 
@@ -293,6 +309,7 @@ void child_manager_plugin_t::on_init(message::init_response_t &message) noexcept
            right after creation */
         if (actor_found) {
             it_actor->second->initialized = true;
+            initializing_actors.erase(address);
             bool do_start = (address == actor->get_address()) ? (self_state <= state_t::OPERATIONAL)
                                                               : !sup.access<to::synchronize_start>();
             if (do_start) {
@@ -327,7 +344,7 @@ void child_manager_plugin_t::cancel_init(const actor_base_t *child) noexcept {
         // options: answer instead of actor (easier, but unexpected message can be seen)
         // or forget the init-request.
         auto &timer_id = init_request->payload.id;
-        if (sup.access<to::timers_map>().count(timer_id)) {
+        if (sup.access<to::request_map>().contains(timer_id)) {
             sup.access<to::discard_request, request_id_t>(timer_id);
         }
     }
@@ -371,7 +388,9 @@ bool child_manager_plugin_t::handle_shutdown(message::shutdown_request_t *req) n
         reason = actor->access<to::shutdown_reason>();
     }
     assert(reason);
-    request_shutdown(reason);
+    if (shutdown_unrequested) {
+        request_shutdown(reason);
+    }
 
     /* only own actor left, which will be handled differently */
     return active_actors() == 1 && plugin_base_t::handle_shutdown(req);
@@ -410,6 +429,7 @@ void child_manager_plugin_t::request_shutdown(detail::child_info_t &child_state,
 }
 
 void child_manager_plugin_t::request_shutdown(const extended_error_ptr_t &reason) noexcept {
+    shutdown_unrequested = false;
     for (auto &it : actors_map) {
         auto &info = *it.second;
         if (info.actor) {
@@ -452,33 +472,35 @@ void child_manager_plugin_t::handle_start(message::start_trigger_t *trigger) noe
     return plugin_base_t::handle_start(trigger);
 }
 
-bool child_manager_plugin_t::has_initializing() const noexcept {
-    auto init_predicate = [&](auto &it) {
-        auto &info = *it.second;
-        auto &child = info.actor;
-        if (!child) {
-            return false;
+bool child_manager_plugin_t::has_initializing() noexcept {
+    // the child state is changed by the child itself, so the entries which are not
+    // initializing any longer are purged here; each entry is purged at most once
+    while (!initializing_actors.empty()) {
+        auto it = initializing_actors.begin();
+        auto it_actor = actors_map.find(*it);
+        if (it_actor != actors_map.end()) {
+            auto &info = *it_actor->second;
+            auto &child = info.actor;
+            if (child && !info.initialized && child->template access<to::state>() <= state_t::INITIALIZING) {
+                return true;
+            }
         }
-        auto &state = child->template access<to::state>();
-        bool still_initializing =
-            (it.first != actor->get_address()) && (state <= state_t::INITIALIZING) && !info.initialized;
-        return still_initializing;
-    };
-    bool has_any = std::any_of(actors_map.begin(), actors_map.end(), init_predicate);
-    return has_any;
+        initializing_actors.erase(it);
+    }
+    return false;
 }
 
 size_t child_manager_plugin_t::active_actors() noexcept {
-    size_t r = 0;
     auto state = actor->access<to::state>();
-    for (auto &it : actors_map) {
-        auto &info = *it.second;
-        bool is_alive = info.actor || info.timer_id || (info.active && (state <= state_t::SHUTTING_DOWN));
-        if (is_alive) {
-            ++r;
-        }
+    return live_children + ((state <= state_t::SHUTTING_DOWN) ? idle_spawners : 0);
+}
+
+void child_manager_plugin_t::track(const detail::child_info_t &info, std::ptrdiff_t delta) noexcept {
+    if (info.actor || info.timer_id) {
+        live_children += delta;
+    } else if (info.active) {
+        idle_spawners += delta;
     }
-    return r;
 }
 
 void child_manager_plugin_t::spawn(factory_t factory, const pt::time_duration &period, restart_policy_t policy,
@@ -487,6 +509,7 @@ void child_manager_plugin_t::spawn(factory_t factory, const pt::time_duration &p
     auto info = detail::child_info_ptr_t{};
     auto spawner_address = sup.make_address();
     info = new detail::child_info_t(spawner_address, std::move(factory), policy, period, max_attempts, escalate);
+    track(*info, 1);
     actors_map.emplace(spawner_address, std::move(info));
     sup.send<payload::spawn_actor_t>(sup.get_address(), spawner_address);
 }
@@ -495,15 +518,20 @@ void child_manager_plugin_t::on_spawn_timer(request_id_t timer_id, bool cancelle
     auto it = spawning_map.find(timer_id);
     assert(it != spawning_map.end());
     auto info = it->second;
-    info->timer_id = 0;
     spawning_map.erase(it);
+    track(*info, -1);
+    info->timer_id = 0;
     if (cancelled) {
         info->active = false;
-        auto &state = actor->access<to::state>();
+    }
+    track(*info, 1);
+
+    auto &state = actor->access<to::state>();
+    if (cancelled) {
         if (state == state_t::SHUTTING_DOWN) {
             actor->shutdown_continue();
         }
-    } else if (actor->access<to::state>() <= state_t::OPERATIONAL) {
+    } else if (state <= state_t::OPERATIONAL) {
         actor->send<payload::spawn_actor_t>(actor->get_address(), info->address);
     }
 }
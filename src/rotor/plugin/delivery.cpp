@@ -8,6 +8,7 @@
 #include "rotor/supervisor.h"
 #include "rotor/messages.hpp"
 #include <boost/core/demangle.hpp>
+#include <algorithm>
 #include <iostream>
 #include <cstdlib>
 #include <sstream>
@@ -19,6 +20,12 @@ namespace {
 namespace to {
 struct main_address {};
 } // namespace to
+
+inline void prefetch([[maybe_unused]] const void *ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr);
+#endif
+}
 } // namespace
 
 template <> auto &subscription_t::access<to::main_address>() noexcept { return main_address; }
@@ -33,23 +40,75 @@ void delivery_plugin_base_t::activate(actor_base_t *actor_) noexcept {
     sup->delivery = this;
 }
 
-void local_delivery_t::delivery(message_ptr_t &message,
+void delivery_plugin_base_t::handoff(message_ptr_t &message) noexcept {
+    // batches are per destination locality, i.e. the FIFO order of all messages to it is kept
+    auto dest = message->address->supervisor.locality_leader;
+    message->share();
+    auto raw_message = message.detach();
+    for (auto &batch : handoff_batches) {
+        if (batch.supervisor == dest) {
+            batch.last->next_inbound = raw_message;
+            batch.last = raw_message;
+            ++batch.count;
+            return;
+        }
+    }
+    handoff_batches.emplace_back(handoff_batch_t{dest, raw_message, raw_message, 1});
+}
+
+void delivery_plugin_base_t::flush_handoffs() noexcept {
+    for (auto &batch : handoff_batches) {
+        ++handoff_stats.wakeups;
+        handoff_stats.messages += batch.count;
+        batch.supervisor->enqueue_batch(batch.first);
+    }
+    handoff_batches.clear();
+    handoff_window_count = 0;
+}
+
+bool delivery_plugin_base_t::expire(message_base_t &message) noexcept {
+    if (message_base_t::deadline_clock_t::now() < message.deadline) {
+        return false;
+    }
+    ++expiry_stats.messages;
+    auto sup = static_cast<supervisor_t *>(actor);
+    auto reason = make_error(make_error_code(error_code_t::request_timeout));
+    auto notification = message.expire(reason);
+    if (notification) {
+        ++expiry_stats.requests;
+        sup->put(std::move(notification));
+    }
+    return true;
+}
+
+void local_delivery_t::delivery(delivery_plugin_base_t &plugin, message_ptr_t &message,
                                 const subscription_t::joint_handlers_t &local_recipients) noexcept {
-    for (auto &handler : local_recipients.external) {
-        auto &sup = handler->actor_ptr->get_supervisor();
+    auto &external = local_recipients.external;
+    for (auto it = external.begin(); it != external.end();) {
+        auto &sup = (*it)->actor_ptr->get_supervisor();
+        auto other_sup = [&sup](auto &item) { return &item->actor_ptr->get_supervisor() != &sup; };
+        auto group_end = std::find_if(it + 1, external.end(), other_sup);
         auto &address = sup.get_address();
-        auto wrapped_message = make_message<payload::handler_call_t>(address, message, handler);
-        sup.enqueue(std::move(wrapped_message));
+        auto wrapped_message = make_message<payload::handler_call_t>(address, message, it, group_end);
+        wrapped_message->priority = message->priority;
+        plugin.handoff(wrapped_message);
+        it = group_end;
     }
-    for (auto &handler : local_recipients.internal) {
-        handler->call(message);
+    // the handler might forget the last subscription, i.e. destroy the recipients
+    auto it = local_recipients.internal.data();
+    auto end = it + local_recipients.internal.size();
+    for (; it != end; ++it) {
+        if (it + 1 != end) {
+            prefetch((it + 1)->handler);
+        }
+        it->thunk(*it->handler, message);
     }
 }
 
 std::string inspected_local_delivery_t::identify(const message_base_t *message, std::int32_t threshold) noexcept {
     using boost::core::demangle;
     using T = owner_tag_t;
-    std::string info = demangle((const char *)message->type_index);
+    std::string info = demangle(message_support::type_name(message->type_index));
     std::int32_t level = 5;
     auto dump_point = [](const subscription_point_t &p) -> std::string {
         std::stringstream out;
@@ -68,8 +127,8 @@ std::string inspected_local_delivery_t::identify(const message_base_t *message,
             out << "A";
             break;
         }
-        out << "] m: " << demangle((const char *)p.handler->message_type()) << ", addr: " << (void *)p.address.get()
-            << " ";
+        out << "] m: " << demangle(message_support::type_name(p.handler->message_type()))
+            << ", addr: " << (void *)p.address.get() << " ";
         return out.str();
     };
 
@@ -174,10 +233,10 @@ static void dump_message(const char *prefix, const message_ptr_t &message) noexc
     }
 }
 
-void inspected_local_delivery_t::delivery(message_ptr_t &message,
+void inspected_local_delivery_t::delivery(delivery_plugin_base_t &plugin, message_ptr_t &message,
                                           const subscription_t::joint_handlers_t &local_recipients) noexcept {
     dump_message(">> ", message);
-    local_delivery_t::delivery(message, local_recipients);
+    local_delivery_t::delivery(plugin, message, local_recipients);
 }
 
 void inspected_local_delivery_t::discard(message_ptr_t &message) noexcept { dump_message("<DISCARDED> ", message); }
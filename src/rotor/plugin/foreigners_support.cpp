@@ -47,23 +47,23 @@ void foreigners_support_plugin_t::deactivate() noexcept {
 }
 
 void foreigners_support_plugin_t::on_call(message::handler_call_t &message) noexcept {
-    auto &handler = message.payload.handler;
-    auto child_actor = handler->actor_ptr;
-    // need to check, that
-    // 1. children exists
-    // 2. check it's state
-    // 2. it is still subscribed to the message
-
     auto &sup = static_cast<supervisor_t &>(*actor);
-    if (sup.access<to::alive_actors>().count(child_actor)) {
-        if (child_actor->access<to::state>() < state_t::SHUT_DOWN) {
-            auto &orig_message = message.payload.orig_message;
-            auto point = subscription_point_t(handler, orig_message->address);
-            auto lifetime = child_actor->access<to::lifetime>();
-            if (lifetime) {
-                auto &points = lifetime->access<to::points>();
-                if (points.find(point) != points.end()) {
-                    handler->call(orig_message);
+    auto &orig_message = message.payload.orig_message;
+    for (auto &handler : message.payload.handlers) {
+        auto child_actor = handler->actor_ptr;
+        // need to check, that
+        // 1. children exists
+        // 2. check it's state
+        // 2. it is still subscribed to the message
+        if (sup.access<to::alive_actors>().count(child_actor)) {
+            if (child_actor->access<to::state>() < state_t::SHUT_DOWN) {
+                auto point = subscription_point_t(handler, orig_message->address);
+                auto lifetime = child_actor->access<to::lifetime>();
+                if (lifetime) {
+                    auto &points = lifetime->access<to::points>();
+                    if (points.find(point) != points.end()) {
+                        handler->call(orig_message);
+                    }
                 }
             }
         }
@@ -16,6 +16,7 @@ struct state {};
 struct shutdown_request {};
 struct shutdown_timeout {};
 struct link_server {};
+struct discard_request {};
 } // namespace to
 } // namespace
 
@@ -23,6 +24,9 @@ template <> auto &actor_base_t::access<to::state>() noexcept { return state; }
 template <> auto &actor_base_t::access<to::shutdown_request>() noexcept { return shutdown_request; }
 template <> auto &actor_base_t::access<to::shutdown_timeout>() noexcept { return shutdown_timeout; }
 template <> auto &actor_base_t::access<to::link_server>() noexcept { return link_server; }
+template <> auto supervisor_t::access<to::discard_request, request_id_t>(request_id_t request_id) noexcept {
+    return discard_request(request_id);
+}
 
 const std::type_index link_server_plugin_t::class_identity = typeid(link_server_plugin_t);
 
@@ -72,7 +76,7 @@ void link_server_plugin_t::on_unlink_notify(message::unlink_notify_t &message) n
 
     auto &unlink_request = it->second.unlink_request;
     if (unlink_request) {
-        actor->get_supervisor().cancel_timer(*unlink_request);
+        actor->get_supervisor().access<to::discard_request, request_id_t>(*unlink_request);
     }
     linked_clients.erase(it);
 
@@ -14,15 +14,15 @@ namespace {
 namespace to {
 struct parent {};
 struct locality_leader {};
-struct inbound_queue {};
-struct inbound_queue_size {};
+struct message_pool {};
+struct message_pool_size {};
 } // namespace to
 } // namespace
 
 template <> auto &supervisor_t::access<to::parent>() noexcept { return parent; }
 template <> auto &supervisor_t::access<to::locality_leader>() noexcept { return locality_leader; }
-template <> auto &supervisor_t::access<to::inbound_queue>() noexcept { return inbound_queue; }
-template <> auto &supervisor_t::access<to::inbound_queue_size>() noexcept { return inbound_queue_size; }
+template <> auto &supervisor_t::access<to::message_pool>() noexcept { return message_pool; }
+template <> auto &supervisor_t::access<to::message_pool_size>() noexcept { return message_pool_size; }
 
 const std::type_index locality_plugin_t::class_identity = typeid(locality_plugin_t);
 
@@ -36,8 +36,10 @@ void locality_plugin_t::activate(actor_base_t *actor_) noexcept {
     auto locality_leader = use_other ? parent->access<to::locality_leader>() : &sup;
     sup.access<to::locality_leader>() = locality_leader;
     if (!use_other) {
-        auto sz = sup.access<to::inbound_queue_size>();
-        sup.access<to::inbound_queue>().reserve_unsafe(sz);
+        auto pool_size = sup.access<to::message_pool_size>();
+        if (pool_size) {
+            sup.access<to::message_pool>().reset(new message_pool_t(pool_size));
+        }
     }
     return plugin_base_t::activate(actor_);
 }
@@ -41,7 +41,7 @@ void starter_plugin_t::deactivate() noexcept {
 
 bool starter_plugin_t::handle_subscription(message::subscription_t &message) noexcept {
     auto &point = message.payload.point;
-    auto it = std::find_if(tracked.begin(), tracked.end(), [&](auto info) { return *info == point; });
+    auto it = tracked.find(point);
     if (it != tracked.end()) {
         tracked.erase(it);
     }
@@ -22,6 +22,43 @@ template <> auto &subscription_info_t::access<to::internal_handler>() noexcept {
 
 subscription_t::subscription_t() noexcept : main_address{nullptr} {}
 
+subscription_t::~subscription_t() {
+    for (auto &it : internal_infos) {
+        auto &address = *it.first;
+        delete address.dispatch_table;
+        address.dispatch_table = nullptr;
+    }
+}
+
+void subscription_t::index(address_t &address, const void *message_type,
+                           const joint_handlers_t &handlers) noexcept {
+    auto &table = address.dispatch_table;
+    if (!table) {
+        table = new detail::dispatch_table_t();
+    }
+    table->type_ids.emplace_back(message_support::type_id(message_type));
+    table->handlers.emplace_back(&handlers);
+}
+
+void subscription_t::unindex(address_t &address, const void *message_type) noexcept {
+    auto &table = address.dispatch_table;
+    assert(table);
+    auto &ids = table->type_ids;
+    auto it = std::find(ids.begin(), ids.end(), message_support::type_id(message_type));
+    assert(it != ids.end());
+    auto index = static_cast<std::size_t>(it - ids.begin());
+    if (ids.size() == 1) {
+        delete table;
+        table = nullptr;
+        return;
+    }
+    ids[index] = ids.back();
+    ids.pop_back();
+    auto &handlers = table->handlers;
+    handlers[index] = handlers.back();
+    handlers.pop_back();
+}
+
 subscription_info_ptr_t subscription_t::materialize(const subscription_point_t &point) noexcept {
     using State = subscription_info_t::state_t;
     auto &address = point.address;
@@ -35,10 +72,22 @@ subscription_info_ptr_t subscription_t::materialize(const subscription_point_t &
         auto &info_list = internal_infos[address];
         info_list.emplace_back(info);
 
-        auto insert_result = mine_handlers.try_emplace({address.get(), handler->message_type()});
+        auto message_type = handler->message_type();
+        auto insert_result = mine_handlers.try_emplace({address.get(), message_type});
         auto &joint_handlers = insert_result.first->second;
-        auto &handlers = internal_handler ? joint_handlers.internal : joint_handlers.external;
-        handlers.emplace_back(handler.get());
+        if (insert_result.second) {
+            index(*address, message_type, joint_handlers);
+        }
+        if (internal_handler) {
+            joint_handlers.internal.emplace_back(handler_entry_t{handler->thunk, handler.get()});
+        } else {
+            // keep handlers grouped by supervisor, i.e. insert after the last one of the same supervisor
+            auto &handlers = joint_handlers.external;
+            auto sup = &handler->actor_ptr->get_supervisor();
+            auto same_sup = [sup](auto &item) { return &item->actor_ptr->get_supervisor() == sup; };
+            auto rit = std::find_if(handlers.rbegin(), handlers.rend(), same_sup);
+            handlers.insert(rit.base(), handler.get());
+        }
     }
 
     return info;
@@ -53,21 +102,32 @@ void subscription_t::update(subscription_point_t &point, handler_ptr_t &new_hand
         auto it = mine_handlers.find({address.get(), handler->message_type()});
         assert(it != mine_handlers.end());
         auto &joint_handlers = it->second;
-        auto &handlers = internal_handler ? joint_handlers.internal : joint_handlers.external;
-        auto it_handler = std::find(handlers.begin(), handlers.end(), handler.get());
-        assert(it_handler != handlers.end());
-        *it_handler = new_handler.get();
+        if (internal_handler) {
+            auto &entries = joint_handlers.internal;
+            auto predicate = [&handler](auto &item) { return item.handler == handler.get(); };
+            auto it_entry = std::find_if(entries.begin(), entries.end(), predicate);
+            assert(it_entry != entries.end());
+            *it_entry = handler_entry_t{new_handler->thunk, new_handler.get()};
+        } else {
+            auto &handlers = joint_handlers.external;
+            auto it_handler = std::find(handlers.begin(), handlers.end(), handler.get());
+            assert(it_handler != handlers.end());
+            *it_handler = new_handler.get();
+        }
     }
     point.handler = new_handler;
 }
 
 const subscription_t::joint_handlers_t *subscription_t::get_recipients(const message_base_t &message) const noexcept {
-    auto address = message.address.get();
-    auto message_type = message.type_index;
-    auto key = subscription_key_t{address, message_type};
-    auto it = mine_handlers.find(key);
-    if (it != mine_handlers.end()) {
-        return &it->second;
+    auto table = message.address->dispatch_table;
+    if (table) {
+        auto type_id = message_support::type_id(message.type_index);
+        auto &ids = table->type_ids;
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] == type_id) {
+                return table->handlers[i];
+            }
+        }
     }
     return nullptr;
 }
@@ -91,14 +151,20 @@ void subscription_t::forget(const subscription_info_ptr_t &info) noexcept {
     auto handler_ptr = info->handler.get();
     auto it = mine_handlers.find({info->address.get(), handler_ptr->message_type()});
     auto &joint_handlers = it->second;
-    auto internal_handler = info->access<to::internal_handler>();
-    auto &handlers = internal_handler ? joint_handlers.internal : joint_handlers.external;
-    auto &misc_handlers = !internal_handler ? joint_handlers.internal : joint_handlers.external;
-    auto predicate = [&handler_ptr](auto &item) { return item == handler_ptr; };
-    auto handler_it = std::find_if(handlers.begin(), handlers.end(), predicate);
-    assert(handler_it != handlers.end());
-    handlers.erase(handler_it);
-    if (handlers.empty() && misc_handlers.empty()) {
+    if (info->access<to::internal_handler>()) {
+        auto &entries = joint_handlers.internal;
+        auto predicate = [&handler_ptr](auto &item) { return item.handler == handler_ptr; };
+        auto entry_it = std::find_if(entries.begin(), entries.end(), predicate);
+        assert(entry_it != entries.end());
+        entries.erase(entry_it);
+    } else {
+        auto &handlers = joint_handlers.external;
+        auto handler_it = std::find(handlers.begin(), handlers.end(), handler_ptr);
+        assert(handler_it != handlers.end());
+        handlers.erase(handler_it);
+    }
+    if (joint_handlers.internal.empty() && joint_handlers.external.empty()) {
+        unindex(*info->address, handler_ptr->message_type());
         mine_handlers.erase(it);
     }
 }
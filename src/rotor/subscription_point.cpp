@@ -6,6 +6,8 @@
 
 #include "rotor/subscription.h"
 #include "rotor/supervisor.h"
+#include <cassert>
+#include <iterator>
 
 namespace rotor {
 
@@ -25,15 +27,47 @@ bool subscription_point_t::operator==(const subscription_point_t &other) const n
     return address == other.address && (*handler == *other.handler);
 }
 
+auto subscription_container_t::key_of(const subscription_point_t &point) noexcept -> index_key_t {
+    auto &handler = *point.handler;
+    return index_key_t{handler.handler_type, handler.actor_ptr, point.address.get()};
+}
+
 subscription_container_t::iterator subscription_container_t::find(const subscription_point_t &point) noexcept {
-    auto predicate = [&point](auto &info) {
-        return *info->handler == *point.handler && info->address == point.address;
-    };
-    auto rit = std::find_if(rbegin(), rend(), predicate);
-    if (rit == rend()) {
-        return end();
+    auto it = index.find(key_of(point));
+    if (it == index.end()) {
+        return items.end();
     }
-    return --rit.base();
+    return it->second.last;
+}
+
+void subscription_container_t::emplace_back(const subscription_info_ptr_t &info) noexcept {
+    auto it = items.emplace(items.end(), info);
+    auto [slot, inserted] = index.try_emplace(key_of(*info), slot_t{it, 0});
+    slot->second.last = it;
+    ++slot->second.count;
+}
+
+subscription_container_t::iterator subscription_container_t::erase(iterator it) noexcept {
+    auto key = key_of(**it);
+    auto slot = index.find(key);
+    assert(slot != index.end());
+    auto &[last, count] = slot->second;
+    if (!--count) {
+        index.erase(slot);
+    } else if (last == it) {
+        // rare case of duplicate points: look for the previous one
+        auto rit = std::make_reverse_iterator(it);
+        while (!(key_of(**rit) == key)) {
+            ++rit;
+        }
+        last = --rit.base();
+    }
+    return items.erase(it);
+}
+
+void subscription_container_t::clear() noexcept {
+    index.clear();
+    items.clear();
 }
 
 void subscription_info_t::tag(const void *t) noexcept {
@@ -6,6 +6,7 @@
 
 #include "rotor/supervisor.h"
 #include "rotor/registry.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace rotor;
@@ -24,17 +25,24 @@ template <> auto &subscription_info_t::access<to::internal_handler>() noexcept {
 
 supervisor_t::supervisor_t(supervisor_config_t &config)
     : actor_base_t(config), last_req_id{0}, parent{config.supervisor},
-      inbound_queue(0), inbound_queue_size{config.inbound_queue_size}, poll_duration{config.poll_duration},
+      message_pool_size{config.message_pool_size}, poll_duration{config.poll_duration},
       shutdown_flag{config.shutdown_flag}, shutdown_poll_frequency{config.shutdown_poll_frequency},
+      request_tick{config.request_tick},
+      request_wheel{std::chrono::microseconds{std::max<std::int64_t>(1, request_tick.total_microseconds())},
+                    timer_clock_t::now()},
       create_registry(config.create_registry), synchronize_start(config.synchronize_start),
       registry_address(config.registry_address), policy{config.policy} {
     supervisor = this;
 }
 
-supervisor_t::~supervisor_t() {
-    message_base_t *ptr;
-    while (inbound_queue.pop(ptr)) {
-        intrusive_ptr_release(ptr);
+supervisor_t::~supervisor_t() { inbound_queue.clear(); }
+
+void supervisor_t::enqueue_batch(message_base_t *first) noexcept {
+    while (first) {
+        auto next = first->next_inbound;
+        first->next_inbound = nullptr;
+        enqueue(message_ptr_t(first, false));
+        first = next;
     }
 }
 
@@ -119,33 +127,90 @@ void supervisor_t::on_child_shutdown(actor_base_t *) noexcept {
 void supervisor_t::intercept(message_ptr_t &, const void *, const continuation_t &cont) noexcept { cont(); }
 
 void supervisor_t::on_request_trigger(request_id_t timer_id, bool cancelled) noexcept {
-    auto it = request_map.find(timer_id);
-    if (it != request_map.end()) {
-        auto &request_curry = it->second;
-        auto &actor = *request_curry.source;
+    auto request_curry = request_map.find(timer_id);
+    if (request_curry) {
         if (!cancelled) {
-            message_ptr_t &request = request_curry.request_message;
+            auto &actor = *request_curry->source;
+            message_ptr_t &request = request_curry->request_message;
             auto ec = make_error_code(error_code_t::request_timeout);
             auto &source = actor.access<to::identity>();
             auto reason = ::make_error(source, ec);
-            auto timeout_message = request_curry.fn(request_curry.origin, *request, reason);
+            auto timeout_message = request_curry->fn(request_curry->origin, *request, reason);
             put(std::move(timeout_message));
         }
-        auto ait = actor.active_requests.find(timer_id);
-        actor.active_requests.erase(ait);
-        request_map.erase(it);
+        request_map.erase(timer_id);
+    }
+}
+
+bool supervisor_t::queue_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
+    auto deadline = timer_clock_t::now() + std::chrono::microseconds{interval.total_microseconds()};
+    timers_queue.push(handler, deadline);
+    return handler.queue_index == 0;
+}
+
+bool supervisor_t::unqueue_timer(timer_handler_base_t &handler) noexcept {
+    auto was_earliest = handler.queue_index == 0;
+    auto actor_ptr = handler.owner;
+    auto timer_id = handler.request_id;
+    timers_queue.erase(handler);
+    actor_ptr->on_timer_trigger(timer_id, true);
+    return was_earliest;
+}
+
+std::size_t supervisor_t::trigger_timers(const timer_clock_t::time_point &now) noexcept {
+    std::size_t count = 0;
+    while (!timers_queue.empty() && !(now < timers_queue.top().deadline)) {
+        auto handler = timers_queue.pop();
+        handler->owner->on_timer_trigger(handler->request_id, false);
+        ++count;
+    }
+    return count;
+}
+
+void supervisor_t::start_request_timer(request_id_t request_id, const pt::time_duration &timeout) noexcept {
+    if (request_tick.total_microseconds() <= 0) {
+        start_timer(request_id, timeout, *this, &supervisor_t::on_request_trigger);
+        return;
+    }
+    auto deadline = timer_clock_t::now() + std::chrono::microseconds{timeout.total_microseconds()};
+    auto &hook = request_map.find(request_id)->timeout_hook;
+    hook.id = request_id;
+    request_wheel.push(hook, deadline);
+    if (!request_tick_timer) {
+        request_tick_timer = start_timer(request_tick, *this, &supervisor_t::on_request_tick);
+    }
+}
+
+void supervisor_t::on_request_tick(request_id_t, bool cancelled) noexcept {
+    request_tick_timer = 0;
+    if (cancelled) {
+        return;
+    }
+    request_wheel.advance(timer_clock_t::now(),
+                          [this](detail::wheel_hook_t &hook) { on_request_trigger(hook.id, false); });
+    if (!request_wheel.empty()) {
+        request_tick_timer = start_timer(request_tick, *this, &supervisor_t::on_request_tick);
     }
 }
 
 void supervisor_t::discard_request(request_id_t request_id) noexcept {
-    assert(request_map.find(request_id) != request_map.end());
-    cancel_timer(request_id);
-    request_map.erase(request_id);
+    auto curry = request_map.find(request_id);
+    assert(curry);
+    auto &hook = curry->timeout_hook;
+    if (hook.tick) {
+        request_wheel.erase(hook);
+        request_map.erase(request_id);
+    } else {
+        cancel_timer(request_id);
+        if (request_map.contains(request_id)) {
+            request_map.erase(request_id);
+        }
+    }
 }
 
 void supervisor_t::shutdown_finish() noexcept {
     actor_base_t::shutdown_finish();
-    assert(request_map.size() == 0);
+    assert(request_map.empty());
 }
 
 spawner_t supervisor_t::spawn(factory_t factory) noexcept { return spawner_t(std::move(factory), *this); }
@@ -165,7 +230,5 @@ void supervisor_t::on_shutdown_check_timer(request_id_t, bool cancelled) noexcep
 void supervisor_t::uplift_last_message() noexcept {
     auto &queue = locality_leader->queue;
     assert(!queue.empty());
-    auto message = message_ptr_t(queue.back().detach(), false);
-    queue.push_front(std::move(message));
-    queue.pop_back();
+    queue.push_front(queue.pop_back());
 }
@@ -41,9 +41,6 @@ std::string system_context_t::identity() noexcept {
 
 system_context_t::~system_context_t() {
     if (supervisor) {
-        message_base_t *ptr;
-        while (supervisor->access<to::inbound_queue>().pop(ptr)) {
-            intrusive_ptr_release(ptr);
-        }
+        supervisor->access<to::inbound_queue>().clear();
     }
 }
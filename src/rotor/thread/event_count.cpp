@@ -0,0 +1,87 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/thread/event_count.h"
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace rotor::thread;
+
+#if defined(__linux__)
+namespace {
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t), "futex word should be plain 32-bit");
+
+inline void futex_wait(std::atomic<std::uint32_t> &word, std::uint32_t value, const timespec *timeout) noexcept {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAIT_PRIVATE, value, timeout, nullptr, 0);
+}
+
+inline void futex_wake(std::atomic<std::uint32_t> &word) noexcept {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+} // namespace
+#endif
+
+std::uint32_t event_count_t::prepare_wait() noexcept {
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    auto key = epoch.load(std::memory_order_acquire);
+    // pairs with the fence in `notify`: either the consumer sees the condition, or the producer sees the waiter
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return key;
+}
+
+void event_count_t::cancel_wait() noexcept { waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+void event_count_t::wait(std::uint32_t key, const clock_t::time_point &deadline) noexcept {
+    auto unlimited = deadline == clock_t::time_point::max();
+#if defined(__linux__)
+    while (epoch.load(std::memory_order_acquire) == key) {
+        if (unlimited) {
+            futex_wait(epoch, key, nullptr);
+        } else {
+            auto now = clock_t::now();
+            if (!(now < deadline)) {
+                break;
+            }
+            auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+            timespec timeout;
+            timeout.tv_sec = static_cast<time_t>(left / 1000000000);
+            timeout.tv_nsec = static_cast<long>(left % 1000000000);
+            futex_wait(epoch, key, &timeout);
+        }
+    }
+#else
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto predicate = [&]() { return epoch.load(std::memory_order_acquire) != key; };
+        if (unlimited) {
+            cv.wait(lock, predicate);
+        } else {
+            cv.wait_until(lock, deadline, predicate);
+        }
+    }
+#endif
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void event_count_t::notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!waiters.load(std::memory_order_relaxed)) {
+        return;
+    }
+    epoch.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    futex_wake(epoch);
+#else
+    std::lock_guard<std::mutex> lock(mutex);
+    cv.notify_all();
+#endif
+}
@@ -23,10 +23,22 @@ void supervisor_thread_t::shutdown() noexcept {
 }
 
 void supervisor_thread_t::enqueue(message_ptr_t message) noexcept {
+    message->share();
+    auto leader = static_cast<supervisor_thread_t *>(locality_leader);
+    leader->inbound_queue.push(message.detach());
+    wakeup();
+}
+
+void supervisor_thread_t::enqueue_batch(message_base_t *first) noexcept {
+    auto leader = static_cast<supervisor_thread_t *>(locality_leader);
+    leader->inbound_queue.push_batch(first);
+    wakeup();
+}
+
+void supervisor_thread_t::wakeup() noexcept {
+    // no syscall, unless the thread is parked
     auto ctx = static_cast<system_context_thread_t *>(context);
-    inbound_queue.push(message.detach());
-    std::lock_guard<std::mutex> lock(ctx->mutex);
-    ctx->cv.notify_one();
+    ctx->events.notify();
 }
 
 void supervisor_thread_t::intercept(message_ptr_t &message, const void *tag,
@@ -48,9 +60,9 @@ void supervisor_thread_t::do_start_timer(const pt::time_duration &interval, time
     ctx->start_timer(interval, handler);
 }
 
-void supervisor_thread_t::do_cancel_timer(request_id_t timer_id) noexcept {
+void supervisor_thread_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
     auto ctx = static_cast<system_context_thread_t *>(context);
-    ctx->cancel_timer(timer_id);
+    ctx->cancel_timer(handler);
 }
 
 void supervisor_thread_t::update_time() noexcept {
@@ -6,6 +6,7 @@
 
 #include "rotor/thread/system_context_thread.h"
 #include "rotor/supervisor.h"
+#include <algorithm>
 #include <chrono>
 
 namespace rotor {
@@ -33,68 +34,101 @@ inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool
 
 using time_units_t = std::chrono::microseconds;
 
-system_context_thread_t::system_context_thread_t() noexcept { update_time(); }
+system_context_thread_t::system_context_thread_t(idle_strategy_t idle_strategy_, bool adaptive) noexcept
+    : idle_strategy{idle_strategy_}, budget{spin_budget_t::duration_t::zero(), adaptive} {
+    update_time();
+}
 
 void system_context_thread_t::run() noexcept {
-    using std::chrono::duration_cast;
     auto &root_sup = *get_supervisor();
     auto condition = [&]() -> bool { return root_sup.access<to::state>() != state_t::SHUT_DOWN; };
-    auto &queue = root_sup.access<to::queue>();
-    auto &inbound = root_sup.access<to::inbound_queue>();
     auto &poll_duration = root_sup.access<to::poll_duration>();
+    budget = spin_budget_t(time_units_t{poll_duration.total_microseconds()}, budget.adaptive);
 
-    auto process = [&]() -> bool {
-        message_base_t *ptr;
-        if (inbound.pop(ptr)) {
-            queue.emplace_back(ptr, false);
-            return true;
-        }
-        return false;
-    };
-
-    auto delta = time_units_t{poll_duration.total_microseconds()};
     while (condition()) {
         root_sup.do_process();
         if (condition()) {
-            using namespace std::chrono_literals;
-            auto dealine = clock_t::now() + delta;
-            if (!timer_nodes.empty()) {
-                dealine = std::min(dealine, timer_nodes.front().deadline);
-            }
-            // fast stage, indirect spin-lock, cpu consuming
-            while ((clock_t::now() < dealine) && !process()) {
-            }
-            if (queue.empty()) {
-                std::unique_lock<std::mutex> lock(mutex);
-                auto predicate = [&]() { return !inbound.empty(); };
-                // wait notification, do not consume CPU
-                auto next_timer_deadline = !timer_nodes.empty() ? timer_nodes.front().deadline : dealine + 1h;
-                cv.wait_until(lock, next_timer_deadline, predicate);
-            }
+            idle();
             update_time();
-            root_sup.do_process();
         }
     }
 }
 
-void system_context_thread_t::check() noexcept {
+void system_context_thread_t::idle() noexcept {
+    auto &root_sup = *get_supervisor();
+    auto &queue = root_sup.access<to::queue>();
+    auto &inbound = root_sup.access<to::inbound_queue>();
+    if (!queue.empty()) {
+        return;
+    }
+
+    auto start = clock_t::now();
+    auto timer_deadline = !timers.empty() ? timers.top().deadline : clock_t::time_point::max();
+    auto spin_deadline = start + std::chrono::duration_cast<clock_t::duration>(budget.value);
+    if (spin(std::min(timer_deadline, spin_deadline))) {
+        budget.update(clock_t::now() - start);
+        return;
+    }
+    if (!(clock_t::now() < timer_deadline)) {
+        return;
+    }
+
+    // slow stage, do not consume CPU
+    auto key = events.prepare_wait();
+    if (!inbound.empty()) {
+        events.cancel_wait();
+    } else {
+        events.wait(key, timer_deadline);
+    }
+    if (inbound.drain(queue)) {
+        budget.update(clock_t::now() - start);
+    }
+}
+
+bool system_context_thread_t::spin(const clock_t::time_point &deadline) noexcept {
+    static constexpr std::uint32_t max_relaxes = 64;
     auto &root_sup = *get_supervisor();
     auto &queue = root_sup.access<to::queue>();
     auto &inbound = root_sup.access<to::inbound_queue>();
-    message_base_t *ptr;
-    while (inbound.pop(ptr)) {
-        queue.emplace_back(ptr, false);
+    if (idle_strategy == idle_strategy_t::park) {
+        return false;
     }
+
+    // fast stage, cpu consuming
+    std::uint32_t relaxes = 1;
+    while (clock_t::now() < deadline) {
+        if (inbound.drain(queue)) {
+            return true;
+        }
+        if (idle_strategy == idle_strategy_t::pause_spin) {
+            cpu_relax();
+        } else if (idle_strategy == idle_strategy_t::backoff) {
+            if (relaxes < max_relaxes) {
+                for (std::uint32_t i = 0; i < relaxes; ++i) {
+                    cpu_relax();
+                }
+                relaxes *= 2;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    return false;
+}
+
+void system_context_thread_t::check() noexcept {
+    auto &root_sup = *get_supervisor();
+    auto &queue = root_sup.access<to::queue>();
+    root_sup.access<to::inbound_queue>().drain(queue);
     update_time();
 }
 
 void system_context_thread_t::update_time() noexcept {
     now = clock_t::now();
-    auto it = timer_nodes.begin();
-    while (it != timer_nodes.end() && it->deadline < now) {
-        auto actor_ptr = it->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(it->handler->request_id, false);
-        it = timer_nodes.erase(it);
+    while (!timers.empty() && timers.top().deadline < now) {
+        auto handler = timers.pop();
+        auto actor_ptr = handler->owner;
+        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(handler->request_id, false);
     }
 }
 
@@ -102,24 +136,16 @@ void system_context_thread_t::start_timer(const pt::time_duration &interval, tim
     if (intercepting)
         update_time();
     auto deadline = now + time_units_t{interval.total_microseconds()};
-    auto it = timer_nodes.begin();
-    for (; it != timer_nodes.end(); ++it) {
-        if (deadline < it->deadline) {
-            break;
-        }
-    }
-    timer_nodes.insert(it, deadline_info_t{&handler, deadline});
+    timers.push(handler, deadline);
 }
 
-void system_context_thread_t::cancel_timer(request_id_t timer_id) noexcept {
+void system_context_thread_t::cancel_timer(timer_handler_base_t &handler) noexcept {
+    auto actor_ptr = handler.owner;
+    auto timer_id = handler.request_id;
+    timers.erase(handler);
     if (intercepting)
         update_time();
-    auto predicate = [&](auto &info) { return info.handler->request_id == timer_id; };
-    auto it = std::find_if(timer_nodes.begin(), timer_nodes.end(), predicate);
-    assert(it != timer_nodes.end() && "timer has been found");
-    auto &actor_ptr = it->handler->owner;
     actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-    timer_nodes.erase(it);
 }
 
 } // namespace rotor
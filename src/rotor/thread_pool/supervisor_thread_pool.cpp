@@ -0,0 +1,56 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/thread_pool/supervisor_thread_pool.h"
+#include "rotor/thread_pool/system_context_thread_pool.h"
+
+using namespace rotor;
+using namespace rotor::thread_pool;
+
+address_ptr_t supervisor_thread_pool_t::make_address() noexcept { return instantiate_address(this); }
+
+void supervisor_thread_pool_t::start() noexcept { wakeup(); }
+
+void supervisor_thread_pool_t::shutdown() noexcept {
+    auto &sup_addr = supervisor->get_address();
+    auto ec = make_error_code(shutdown_code_t::normal);
+    auto reason = make_error(ec);
+    auto msg = make_message<payload::shutdown_trigger_t>(sup_addr, address, reason);
+    supervisor->enqueue(msg);
+}
+
+void supervisor_thread_pool_t::enqueue(message_ptr_t message) noexcept {
+    message->share();
+    auto leader = static_cast<supervisor_thread_pool_t *>(locality_leader);
+    leader->inbound_queue.push(message.detach());
+    leader->wakeup();
+}
+
+void supervisor_thread_pool_t::enqueue_batch(message_base_t *first) noexcept {
+    auto leader = static_cast<supervisor_thread_pool_t *>(locality_leader);
+    leader->inbound_queue.push_batch(first);
+    leader->wakeup();
+}
+
+void supervisor_thread_pool_t::wakeup() noexcept {
+    auto ctx = static_cast<system_context_thread_pool_t *>(context);
+    ctx->notify(*this);
+}
+
+bool supervisor_thread_pool_t::process_unit() noexcept {
+    inbound_queue.drain(queue);
+    trigger_timers(timer_clock_t::now());
+    do_process();
+    return state == state_t::SHUT_DOWN;
+}
+
+void supervisor_thread_pool_t::do_start_timer(const pt::time_duration &interval,
+                                              timer_handler_base_t &handler) noexcept {
+    // the deadline is registered in the pool after the unit execution
+    queue_timer(interval, handler);
+}
+
+void supervisor_thread_pool_t::do_cancel_timer(timer_handler_base_t &handler) noexcept { unqueue_timer(handler); }
@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/thread_pool/system_context_thread_pool.h"
+#include "rotor/thread_pool/supervisor_thread_pool.h"
+#include <algorithm>
+
+using namespace rotor;
+using namespace rotor::thread_pool;
+
+namespace {
+// the worker of the pool, executed by the current thread (if any)
+thread_local const system_context_thread_pool_t *current_context = nullptr;
+thread_local std::size_t current_worker = 0;
+} // namespace
+
+system_context_thread_pool_t::system_context_thread_pool_t(std::size_t workers_count) noexcept {
+    if (!workers_count) {
+        workers_count = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    workers.reserve(workers_count);
+    for (std::size_t i = 0; i < workers_count; ++i) {
+        workers.emplace_back(new worker_t());
+    }
+}
+
+void system_context_thread_pool_t::run() noexcept {
+    auto root_sup = get_supervisor();
+    root = static_cast<supervisor_thread_pool_t *>(root_sup.get());
+    stopping.store(false, std::memory_order_release);
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size() - 1);
+    for (std::size_t i = 1; i < workers.size(); ++i) {
+        threads.emplace_back([this, i]() { work(i); });
+    }
+    notify(*root);
+    work(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // release the units, which have not been executed
+    auto release = [this](units_t &units) {
+        for (auto unit : units) {
+            unit->unit_state.store(supervisor_thread_pool_t::unit_state_t::IDLE, std::memory_order_relaxed);
+            intrusive_ptr_release(unit);
+        }
+        pending.fetch_sub(units.size(), std::memory_order_relaxed);
+        units.clear();
+    };
+    for (auto &worker : workers) {
+        release(worker->units);
+    }
+    release(injected);
+    root = nullptr;
+}
+
+void system_context_thread_pool_t::notify(supervisor_thread_pool_t &unit) noexcept {
+    using S = supervisor_thread_pool_t::unit_state_t;
+    auto state = unit.unit_state.load(std::memory_order_relaxed);
+    while (true) {
+        auto desired = state == S::IDLE ? S::SCHEDULED : state == S::RUNNING ? S::NOTIFIED : state;
+        // always read-modify-write, so the pushed messages are visible to the executing worker
+        if (unit.unit_state.compare_exchange_weak(state, desired, std::memory_order_acq_rel,
+                                                  std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    if (state == S::IDLE) {
+        intrusive_ptr_add_ref(&unit);
+        schedule(unit);
+    }
+}
+
+void system_context_thread_pool_t::schedule(supervisor_thread_pool_t &unit, bool front) noexcept {
+    if (current_context == this) {
+        auto &worker = *workers[current_worker];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (front) {
+            worker.units.push_front(&unit);
+        } else {
+            worker.units.push_back(&unit);
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(injected_mutex);
+        injected.push_back(&unit);
+    }
+    pending.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_one();
+    }
+}
+
+supervisor_thread_pool_t *system_context_thread_pool_t::acquire(std::size_t worker_index) noexcept {
+    if (!pending.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    supervisor_thread_pool_t *unit = nullptr;
+    auto take = [&](std::mutex &guard, units_t &units, bool back) {
+        std::lock_guard<std::mutex> lock(guard);
+        if (units.empty()) {
+            return false;
+        }
+        if (back) {
+            unit = units.back();
+            units.pop_back();
+        } else {
+            unit = units.front();
+            units.pop_front();
+        }
+        pending.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    };
+
+    auto &own = *workers[worker_index];
+    if (take(own.mutex, own.units, true) || take(injected_mutex, injected, false)) {
+        return unit;
+    }
+    auto count = workers.size();
+    for (std::size_t i = 1; i < count; ++i) {
+        auto &victim = *workers[(worker_index + i) % count];
+        if (take(victim.mutex, victim.units, false)) {
+            return unit;
+        }
+    }
+    return nullptr;
+}
+
+void system_context_thread_pool_t::execute(supervisor_thread_pool_t &unit) noexcept {
+    using S = supervisor_thread_pool_t::unit_state_t;
+    unit.unit_state.exchange(S::RUNNING, std::memory_order_acq_rel);
+    auto shut_down = unit.process_unit();
+    arm(unit);
+    if (shut_down && &unit == root) {
+        stop();
+    }
+
+    auto state = S::RUNNING;
+    if (unit.unit_state.compare_exchange_strong(state, S::IDLE, std::memory_order_acq_rel)) {
+        intrusive_ptr_release(&unit);
+    } else {
+        // notified during execution: let other units of the worker go first
+        unit.unit_state.exchange(S::SCHEDULED, std::memory_order_acq_rel);
+        schedule(unit, true);
+    }
+}
+
+void system_context_thread_pool_t::arm(supervisor_thread_pool_t &unit) noexcept {
+    auto has_timers = !unit.timers_queue.empty();
+    if (!has_timers && !unit.armed) {
+        return;
+    }
+    if (has_timers && unit.armed && unit.armed_deadline == unit.get_timers_deadline()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(deadlines_mutex);
+    if (unit.armed) {
+        deadlines.erase({unit.armed_deadline, &unit});
+    }
+    unit.armed = has_timers;
+    if (has_timers) {
+        unit.armed_deadline = unit.get_timers_deadline();
+        deadlines.emplace(unit.armed_deadline, &unit);
+    }
+}
+
+bool system_context_thread_pool_t::fire_deadlines() noexcept {
+    std::lock_guard<std::mutex> lock(deadlines_mutex);
+    auto now = clock_t::now();
+    auto it = deadlines.begin();
+    for (; it != deadlines.end() && !(now < it->first); ++it) {
+        // the unit re-arms own deadline after the execution
+        notify(*it->second);
+    }
+    auto fired = it != deadlines.begin();
+    deadlines.erase(deadlines.begin(), it);
+    return fired;
+}
+
+void system_context_thread_pool_t::work(std::size_t worker_index) noexcept {
+    current_context = this;
+    current_worker = worker_index;
+    while (!stopping.load(std::memory_order_acquire)) {
+        if (auto unit = acquire(worker_index); unit) {
+            execute(*unit);
+            continue;
+        }
+        if (fire_deadlines()) {
+            continue;
+        }
+
+        auto deadline = clock_t::time_point::max();
+        {
+            std::lock_guard<std::mutex> lock(deadlines_mutex);
+            if (!deadlines.empty()) {
+                deadline = deadlines.begin()->first;
+            }
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        auto predicate = [&]() {
+            return pending.load(std::memory_order_seq_cst) || stopping.load(std::memory_order_acquire);
+        };
+        if (deadline == clock_t::time_point::max()) {
+            cv.wait(lock, predicate);
+        } else {
+            cv.wait_until(lock, deadline, predicate);
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+    current_context = nullptr;
+}
+
+void system_context_thread_pool_t::stop() noexcept {
+    stopping.store(true, std::memory_order_release);
+    std::lock_guard<std::mutex> lock(mutex);
+    cv.notify_all();
+}
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/uring/ring.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace rotor::uring;
+
+namespace {
+inline int sys_setup(std::uint32_t entries, io_uring_params *params) noexcept {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int sys_enter(int fd, std::uint32_t to_submit, std::uint32_t wait_nr, std::uint32_t flags, const void *arg,
+                     std::size_t arg_size) noexcept {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, wait_nr, flags, arg, arg_size));
+}
+
+template <typename T> inline T *offset(void *base, std::uint32_t value) noexcept {
+    return reinterpret_cast<T *>(static_cast<char *>(base) + value);
+}
+} // namespace
+
+ring_t::~ring_t() { release(); }
+
+void ring_t::release() noexcept {
+    if (sqes) {
+        munmap(sqes, sqes_size);
+        sqes = nullptr;
+    }
+    if (cq_ring && cq_ring != sq_ring) {
+        munmap(cq_ring, cq_ring_size);
+    }
+    cq_ring = nullptr;
+    if (sq_ring) {
+        munmap(sq_ring, sq_ring_size);
+        sq_ring = nullptr;
+    }
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+std::error_code ring_t::setup(std::uint32_t entries) noexcept {
+    auto fail = [this]() {
+        auto ec = std::error_code(errno, std::system_category());
+        release();
+        return ec;
+    };
+
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    fd = sys_setup(entries, &params);
+    if (fd < 0) {
+        return fail();
+    }
+    features = params.features;
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    auto single_mmap = (features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && cq_ring_size > sq_ring_size) {
+        sq_ring_size = cq_ring_size;
+    }
+
+    sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED) {
+        sq_ring = nullptr;
+        return fail();
+    }
+    if (single_mmap) {
+        cq_ring = sq_ring;
+    } else {
+        cq_ring =
+            mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            cq_ring = nullptr;
+            return fail();
+        }
+    }
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    auto sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqes_ptr == MAP_FAILED) {
+        return fail();
+    }
+    sqes = static_cast<io_uring_sqe *>(sqes_ptr);
+
+    sq_head = offset<std::uint32_t>(sq_ring, params.sq_off.head);
+    sq_tail = offset<std::uint32_t>(sq_ring, params.sq_off.tail);
+    sq_array = offset<std::uint32_t>(sq_ring, params.sq_off.array);
+    sq_mask = *offset<std::uint32_t>(sq_ring, params.sq_off.ring_mask);
+    sq_entries = params.sq_entries;
+    sq_local_tail = sq_submitted_tail = *sq_tail;
+
+    cq_head = offset<std::uint32_t>(cq_ring, params.cq_off.head);
+    cq_tail = offset<std::uint32_t>(cq_ring, params.cq_off.tail);
+    cq_mask = *offset<std::uint32_t>(cq_ring, params.cq_off.ring_mask);
+    cqes = offset<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+    return {};
+}
+
+io_uring_sqe *ring_t::get_sqe() noexcept {
+    auto head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if (sq_local_tail - head >= sq_entries) {
+        return nullptr;
+    }
+    auto index = sq_local_tail & sq_mask;
+    auto sqe = sqes + index;
+    std::memset(sqe, 0, sizeof(io_uring_sqe));
+    sq_array[index] = index;
+    ++sq_local_tail;
+    return sqe;
+}
+
+int ring_t::submit(std::uint32_t wait_nr, const std::chrono::nanoseconds *timeout) noexcept {
+    std::uint32_t flags = wait_nr ? IORING_ENTER_GETEVENTS : 0;
+    const void *arg = nullptr;
+    std::size_t arg_size = 0;
+#if defined(IORING_ENTER_EXT_ARG)
+    io_uring_getevents_arg ext_arg;
+#endif
+    if (wait_nr && timeout) {
+        timeout_spec.tv_sec = timeout->count() / 1000000000;
+        timeout_spec.tv_nsec = timeout->count() % 1000000000;
+#if defined(IORING_ENTER_EXT_ARG) && defined(IORING_FEAT_EXT_ARG)
+        if (features & IORING_FEAT_EXT_ARG) {
+            std::memset(&ext_arg, 0, sizeof(ext_arg));
+            ext_arg.ts = reinterpret_cast<std::uint64_t>(&timeout_spec);
+            flags |= IORING_ENTER_EXT_ARG;
+            arg = &ext_arg;
+            arg_size = sizeof(ext_arg);
+        } else
+#endif
+        {
+            // older kernels: one-shot timeout entry; its (possibly late) completion is ignored
+            auto sqe = get_sqe();
+            if (sqe) {
+                sqe->opcode = IORING_OP_TIMEOUT;
+                sqe->fd = -1;
+                sqe->addr = reinterpret_cast<std::uint64_t>(&timeout_spec);
+                sqe->len = 1;
+                sqe->user_data = ignored_tag;
+            } else {
+                wait_nr = 0;
+                flags = 0;
+            }
+        }
+    }
+
+    __atomic_store_n(sq_tail, sq_local_tail, __ATOMIC_RELEASE);
+    auto to_submit = sq_local_tail - sq_submitted_tail;
+    auto r = sys_enter(fd, to_submit, wait_nr, flags, arg, arg_size);
+    auto error = r < 0 ? errno : 0;
+    // without SQPOLL the kernel consumes the entries within the call
+    sq_submitted_tail = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    if (r < 0) {
+        // interrupted or timed out waiting is not an error
+        if (error == ETIME || error == EINTR) {
+            return 0;
+        }
+        return -error;
+    }
+    return r;
+}
+
+io_uring_cqe *ring_t::peek_cqe() noexcept {
+    auto head = *cq_head;
+    if (head == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+        return nullptr;
+    }
+    return cqes + (head & cq_mask);
+}
+
+void ring_t::cqe_seen() noexcept { __atomic_store_n(cq_head, *cq_head + 1, __ATOMIC_RELEASE); }
@@ -0,0 +1,70 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/uring/supervisor_uring.h"
+
+using namespace rotor;
+using namespace rotor::uring;
+
+void supervisor_uring_t::start() noexcept {
+    // no-op
+}
+
+void supervisor_uring_t::shutdown() noexcept {
+    auto &sup_addr = supervisor->get_address();
+    auto ec = make_error_code(shutdown_code_t::normal);
+    auto reason = make_error(ec);
+    auto msg = make_message<rotor::payload::shutdown_trigger_t>(sup_addr, address, reason);
+    supervisor->enqueue(msg);
+}
+
+void supervisor_uring_t::enqueue(message_ptr_t message) noexcept {
+    message->share();
+    auto leader = static_cast<supervisor_uring_t *>(locality_leader);
+    leader->inbound_queue.push(message.detach());
+    if (leader->request_wakeup()) {
+        wakeup();
+    }
+}
+
+void supervisor_uring_t::enqueue_batch(message_base_t *first) noexcept {
+    auto leader = static_cast<supervisor_uring_t *>(locality_leader);
+    leader->inbound_queue.push_batch(first);
+    if (leader->request_wakeup()) {
+        wakeup();
+    }
+}
+
+void supervisor_uring_t::wakeup() noexcept { get_context()->wakeup(); }
+
+void supervisor_uring_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
+    get_context()->start_timer(interval, handler);
+}
+
+void supervisor_uring_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    get_context()->cancel_timer(handler);
+}
+
+io_id_t supervisor_uring_t::read(const address_ptr_t &destination, int fd, void *buffer, std::uint32_t size,
+                                 std::uint64_t offset) noexcept {
+    return get_context()->read(destination, fd, buffer, size, offset);
+}
+
+io_id_t supervisor_uring_t::write(const address_ptr_t &destination, int fd, const void *buffer, std::uint32_t size,
+                                  std::uint64_t offset) noexcept {
+    return get_context()->write(destination, fd, buffer, size, offset);
+}
+
+io_id_t supervisor_uring_t::accept(const address_ptr_t &destination, int fd) noexcept {
+    return get_context()->accept(destination, fd);
+}
+
+io_id_t supervisor_uring_t::connect(const address_ptr_t &destination, int fd, const sockaddr *address,
+                                    socklen_t length) noexcept {
+    return get_context()->connect(destination, fd, address, length);
+}
+
+void supervisor_uring_t::cancel_io(io_id_t id) noexcept { get_context()->cancel_io(id); }
@@ -0,0 +1,291 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor/uring/system_context_uring.h"
+#include "rotor/supervisor.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace rotor {
+using namespace rotor::uring;
+
+namespace {
+namespace to {
+struct state {};
+struct queue {};
+struct inbound_queue {};
+struct on_timer_trigger {};
+} // namespace to
+} // namespace
+
+template <> auto &supervisor_t::access<to::state>() noexcept { return state; }
+template <> auto &supervisor_t::access<to::queue>() noexcept { return queue; }
+template <> auto &supervisor_t::access<to::inbound_queue>() noexcept { return inbound_queue; }
+template <>
+inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool>(request_id_t request_id,
+                                                                                  bool cancelled) noexcept {
+    on_timer_trigger(request_id, cancelled);
+}
+
+using time_units_t = std::chrono::microseconds;
+
+system_context_uring_t::system_context_uring_t(std::uint32_t entries) noexcept {
+    update_time();
+    ec = ring.setup(entries);
+    if (!ec) {
+        event_fd = eventfd(0, EFD_CLOEXEC);
+        if (event_fd < 0) {
+            ec = std::error_code(errno, std::system_category());
+        }
+    }
+}
+
+system_context_uring_t::~system_context_uring_t() {
+    if (event_fd >= 0) {
+        close(event_fd);
+    }
+}
+
+void system_context_uring_t::run() noexcept {
+    auto &root_sup = *get_supervisor();
+    if (ec) {
+        on_error(&root_sup, make_error(identity(), ec));
+        return;
+    }
+    auto condition = [&]() -> bool { return root_sup.access<to::state>() != state_t::SHUT_DOWN; };
+    auto &queue = root_sup.access<to::queue>();
+    auto &inbound = root_sup.access<to::inbound_queue>();
+
+    stopping = false;
+    arm_wakeup();
+    while (condition()) {
+        root_sup.do_process();
+        if (condition()) {
+            if (!wakeup_armed) {
+                // no free submission entry for the eventfd read: poll the inbound queue
+                // and retry, the loop does not sleep until the read is in-flight
+                root_sup.clear_wakeup();
+                inbound.drain(queue);
+                arm_wakeup();
+            }
+            wait();
+            reap();
+            update_time();
+        }
+    }
+    cancel_all();
+}
+
+void system_context_uring_t::update_time() noexcept {
+    now = clock_t::now();
+    while (!timers.empty() && timers.top().deadline < now) {
+        auto handler = timers.pop();
+        auto actor_ptr = handler->owner;
+        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(handler->request_id, false);
+    }
+}
+
+void system_context_uring_t::start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
+    auto deadline = now + time_units_t{interval.total_microseconds()};
+    timers.push(handler, deadline);
+}
+
+void system_context_uring_t::cancel_timer(timer_handler_base_t &handler) noexcept {
+    auto actor_ptr = handler.owner;
+    auto timer_id = handler.request_id;
+    timers.erase(handler);
+    actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
+}
+
+io_uring_sqe *system_context_uring_t::acquire_sqe() noexcept {
+    auto sqe = ring.get_sqe();
+    if (!sqe) {
+        ring.submit(0, nullptr);
+        sqe = ring.get_sqe();
+    }
+    return sqe;
+}
+
+io_uring_sqe *system_context_uring_t::start_io(io_op_t *op) noexcept {
+    auto id = op->id;
+    ops.emplace(id, io_op_ptr_t(op));
+    auto sqe = acquire_sqe();
+    if (!sqe) {
+        complete(id, -EBUSY);
+        return nullptr;
+    }
+    sqe->fd = op->fd;
+    sqe->user_data = id;
+    return sqe;
+}
+
+io_id_t system_context_uring_t::read(const address_ptr_t &destination, int fd, void *buffer, std::uint32_t size,
+                                     std::uint64_t offset) noexcept {
+    auto op = new io_op_t{++last_io_id, io_operation_t::read, fd, destination, {}, 0};
+    auto id = op->id;
+    if (auto sqe = start_io(op); sqe) {
+        sqe->opcode = IORING_OP_READ;
+        sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+        sqe->len = size;
+        sqe->off = offset;
+    }
+    return id;
+}
+
+io_id_t system_context_uring_t::write(const address_ptr_t &destination, int fd, const void *buffer,
+                                      std::uint32_t size, std::uint64_t offset) noexcept {
+    auto op = new io_op_t{++last_io_id, io_operation_t::write, fd, destination, {}, 0};
+    auto id = op->id;
+    if (auto sqe = start_io(op); sqe) {
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->addr = reinterpret_cast<std::uint64_t>(buffer);
+        sqe->len = size;
+        sqe->off = offset;
+    }
+    return id;
+}
+
+io_id_t system_context_uring_t::accept(const address_ptr_t &destination, int fd) noexcept {
+    auto op = new io_op_t{++last_io_id, io_operation_t::accept, fd, destination, {}, sizeof(sockaddr_storage)};
+    auto id = op->id;
+    if (auto sqe = start_io(op); sqe) {
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&op->peer);
+        sqe->addr2 = reinterpret_cast<std::uint64_t>(&op->peer_length);
+        sqe->accept_flags = SOCK_CLOEXEC;
+    }
+    return id;
+}
+
+io_id_t system_context_uring_t::connect(const address_ptr_t &destination, int fd, const sockaddr *address,
+                                        socklen_t length) noexcept {
+    auto op = new io_op_t{++last_io_id, io_operation_t::connect, fd, destination, {}, 0};
+    auto id = op->id;
+    if (length > static_cast<socklen_t>(sizeof(sockaddr_storage))) {
+        ops.emplace(id, io_op_ptr_t(op));
+        complete(id, -EINVAL);
+        return id;
+    }
+    std::memcpy(&op->peer, address, length);
+    op->peer_length = length;
+    if (auto sqe = start_io(op); sqe) {
+        sqe->opcode = IORING_OP_CONNECT;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&op->peer);
+        sqe->off = op->peer_length;
+    }
+    return id;
+}
+
+void system_context_uring_t::complete(io_id_t id, std::int32_t result) noexcept {
+    auto it = ops.find(id);
+    if (it == ops.end()) {
+        return;
+    }
+    auto op = std::move(it->second);
+    ops.erase(it);
+    if (!stopping) {
+        auto &root_sup = *get_supervisor();
+        auto &destination = op->destination;
+        // no thread hop: the completion is put right into the loop queue
+        root_sup.put(make_message<payload::io_completion_t>(destination, id, op->operation, op->fd, result));
+    }
+}
+
+void system_context_uring_t::cancel_io(io_id_t id) noexcept {
+    if (ops.find(id) == ops.end()) {
+        return;
+    }
+    if (auto sqe = acquire_sqe(); sqe) {
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = id;
+        sqe->user_data = ring_t::ignored_tag;
+    }
+}
+
+void system_context_uring_t::wakeup() noexcept {
+    std::uint64_t value = 1;
+    auto r = ::write(event_fd, &value, sizeof(value));
+    (void)r;
+}
+
+void system_context_uring_t::arm_wakeup() noexcept {
+    if (auto sqe = acquire_sqe(); sqe) {
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = event_fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(&event_value);
+        sqe->len = sizeof(event_value);
+        sqe->off = static_cast<std::uint64_t>(-1);
+        sqe->user_data = wakeup_tag;
+        wakeup_armed = true;
+    }
+}
+
+void system_context_uring_t::wait() noexcept {
+    auto &root_sup = *get_supervisor();
+    auto &queue = root_sup.access<to::queue>();
+    // do not sleep, if there are messages to process or wake-ups might be missed
+    std::uint32_t wait_nr = (queue.empty() && wakeup_armed) ? 1 : 0;
+    std::chrono::nanoseconds timeout;
+    std::chrono::nanoseconds *timeout_ptr = nullptr;
+    if (wait_nr && !timers.empty()) {
+        auto left = timers.top().deadline - clock_t::now();
+        if (left.count() > 0) {
+            timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(left);
+            timeout_ptr = &timeout;
+        } else {
+            wait_nr = 0;
+        }
+    }
+    ring.submit(wait_nr, timeout_ptr);
+}
+
+void system_context_uring_t::reap() noexcept {
+    auto &root_sup = *get_supervisor();
+    auto &queue = root_sup.access<to::queue>();
+    auto &inbound = root_sup.access<to::inbound_queue>();
+    while (auto cqe = ring.peek_cqe()) {
+        auto user_data = cqe->user_data;
+        auto result = cqe->res;
+        ring.cqe_seen();
+        if (user_data == wakeup_tag) {
+            wakeup_armed = false;
+            if (!stopping) {
+                root_sup.clear_wakeup();
+                inbound.drain(queue);
+                arm_wakeup();
+            }
+        } else if (user_data >= first_io_id) {
+            complete(user_data, result);
+        }
+    }
+}
+
+void system_context_uring_t::cancel_all() noexcept {
+    stopping = true;
+    for (auto &it : ops) {
+        cancel_io(it.first);
+    }
+    if (wakeup_armed) {
+        if (auto sqe = acquire_sqe(); sqe) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = wakeup_tag;
+            sqe->user_data = ring_t::ignored_tag;
+        }
+    }
+    while (!ops.empty() || wakeup_armed) {
+        if (ring.submit(1, nullptr) < 0) {
+            break;
+        }
+        reap();
+    }
+}
+
+} // namespace rotor
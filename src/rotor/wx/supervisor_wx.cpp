@@ -10,41 +10,12 @@
 using namespace rotor::wx;
 using namespace rotor;
 
-namespace rotor::wx {
-namespace {
-namespace to {
-struct on_timer_trigger {};
-} // namespace to
-} // namespace
-} // namespace rotor::wx
+supervisor_wx_t::timer_t::timer_t(supervisor_wx_t *sup_) : sup{sup_} {}
 
-namespace rotor {
-template <>
-inline auto rotor::actor_base_t::access<to::on_timer_trigger, request_id_t, bool>(request_id_t request_id,
-                                                                                  bool cancelled) noexcept {
-    on_timer_trigger(request_id, cancelled);
-}
-} // namespace rotor
-
-supervisor_wx_t::timer_t::timer_t(timer_handler_base_t *handler_, supervisor_ptr_t &&sup_)
-    : handler{handler_}, sup{std::move(sup_)} {}
-
-void supervisor_wx_t::timer_t::Notify() noexcept {
-    auto timer_id = handler->request_id;
-    auto *supervisor = sup.get();
-    auto &timers_map = sup->timers_map;
-
-    try {
-        auto actor_ptr = timers_map.at(timer_id)->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, false);
-        timers_map.erase(timer_id);
-        supervisor->do_process();
-    } catch (std::out_of_range &ex) {
-        // no-op
-    }
-}
+void supervisor_wx_t::timer_t::Notify() noexcept { sup->on_timer(); }
 
-supervisor_wx_t::supervisor_wx_t(supervisor_config_wx_t &config_) : supervisor_t{config_}, handler{config_.handler} {}
+supervisor_wx_t::supervisor_wx_t(supervisor_config_wx_t &config_)
+    : supervisor_t{config_}, handler{config_.handler}, timer{this} {}
 
 void supervisor_wx_t::start() noexcept {
     supervisor_ptr_t self{this};
@@ -66,30 +37,69 @@ void supervisor_wx_t::shutdown() noexcept {
 }
 
 void supervisor_wx_t::enqueue(message_ptr_t message) noexcept {
-    supervisor_ptr_t self{this};
-    handler->CallAfter([self = std::move(self), message = std::move(message)]() {
+    message->share();
+    auto leader = static_cast<supervisor_wx_t *>(locality_leader);
+    leader->inbound_queue.push(message.detach());
+    if (leader->request_wakeup()) {
+        schedule_process();
+    }
+}
+
+void supervisor_wx_t::enqueue_batch(message_base_t *first) noexcept {
+    auto leader = static_cast<supervisor_wx_t *>(locality_leader);
+    leader->inbound_queue.push_batch(first);
+    if (leader->request_wakeup()) {
+        schedule_process();
+    }
+}
+
+void supervisor_wx_t::schedule_process() noexcept {
+    timer_t::supervisor_ptr_t self{this};
+    handler->CallAfter([self = std::move(self)]() {
         auto &sup = *self;
-        sup.put(message);
+        auto leader = static_cast<supervisor_wx_t *>(sup.locality_leader);
+        leader->clear_wakeup();
+        leader->inbound_queue.drain(leader->queue);
         sup.do_process();
     });
 }
 
 void supervisor_wx_t::do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept {
-    auto self = timer_t::supervisor_ptr_t(this);
-    auto timer = std::make_unique<timer_t>(&handler, std::move(self));
-    auto timeout_ms = static_cast<int>(interval.total_milliseconds());
-    timer->StartOnce(timeout_ms);
-    timers_map.emplace(handler.request_id, std::move(timer));
+    if (queue_timer(interval, handler)) {
+        arm_timer();
+    }
+}
+
+void supervisor_wx_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    if (unqueue_timer(handler)) {
+        arm_timer();
+    }
+}
+
+void supervisor_wx_t::arm_timer() noexcept {
+    auto active = timer.IsRunning();
+    if (timers_queue.empty()) {
+        if (active) {
+            timer.Stop();
+            intrusive_ptr_release(this);
+        }
+        return;
+    }
+
+    using namespace std::chrono;
+    auto delay = ceil<milliseconds>(get_timers_deadline() - timer_clock_t::now()).count();
+    timer.StartOnce(static_cast<int>(delay > 0 ? delay : 0));
+    if (!active) {
+        intrusive_ptr_add_ref(this);
+    }
 }
 
-void supervisor_wx_t::do_cancel_timer(request_id_t timer_id) noexcept {
-    try {
-        auto &timer = timers_map.at(timer_id);
-        timer->Stop();
-        auto actor_ptr = timer->handler->owner;
-        actor_ptr->access<to::on_timer_trigger, request_id_t, bool>(timer_id, true);
-        timers_map.erase(timer_id);
-    } catch (std::out_of_range &ex) {
-        // no-op
+void supervisor_wx_t::on_timer() noexcept {
+    // adopt the reference, held by the (now stopped) native timer
+    auto self = timer_t::supervisor_ptr_t(this, false);
+    auto triggered = trigger_timers(timer_clock_t::now());
+    arm_timer();
+    if (triggered) {
+        do_process();
     }
 }
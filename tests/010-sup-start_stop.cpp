@@ -367,15 +367,8 @@ TEST_CASE("start/shutdown 1 child & 1 supervisor", "[supervisor]") {
     
     CHECK_THAT(act->get_identity(), StartsWith("actor"));
 
-    /* for better coverage */
-    auto last = sup->access<rt::to::last_req_id>();
-    auto &request_map = sup->access<rt::to::request_map>();
-    request_map[last + 1] = r::request_curry_t();
-
     sup->do_process();
-    request_map.clear();
 
-    CHECK(sup->access<rt::to::last_req_id>() > 1);
     CHECK(sup->get_state() == r::state_t::OPERATIONAL);
     CHECK(act->access<rt::to::state>() == r::state_t::OPERATIONAL);
     CHECK(act->access<rt::to::resources>()->has() == 0);
@@ -90,3 +90,89 @@ TEST_CASE("ping-pong", "[supervisor]") {
     ponger.reset();
     REQUIRE(destroyed == 4);
 }
+
+struct sample_t {
+    int value;
+};
+
+struct prioritized_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&prioritized_t::on_sample); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        auto &addr = get_address();
+        send<sample_t>(r::message_priority_t::low, addr, 1);
+        send<sample_t>(addr, 2);
+        send<sample_t>(r::message_priority_t::high, addr, 3);
+        send<sample_t>(r::message_priority_t::low, addr, 4);
+        send<sample_t>(r::message_priority_t::high, addr, 5);
+    }
+
+    void on_sample(r::message_t<sample_t> &msg) noexcept { values.push_back(msg.payload.value); }
+
+    std::vector<int> values;
+};
+
+TEST_CASE("message priorities", "[supervisor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto act = sup->create_actor<prioritized_t>().timeout(rt::default_timeout).finish();
+
+    sup->do_process();
+    CHECK(act->values == std::vector<int>{3, 5, 2, 1, 4});
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
+
+struct quote_t {
+    static constexpr bool conflate = true;
+    std::uint64_t conflation_key() const noexcept { return symbol; }
+    std::uint64_t symbol;
+    int price;
+};
+
+struct quotes_consumer_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>(
+            [](auto &p) { p.subscribe_actor(&quotes_consumer_t::on_quote); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        auto &addr = get_address();
+        for (int i = 0; i < 10; ++i) {
+            send<quote_t>(addr, std::uint64_t(i % 2), i);
+        }
+    }
+
+    void on_quote(r::message_t<quote_t> &msg) noexcept { prices.push_back(msg.payload.price); }
+
+    std::vector<int> prices;
+};
+
+TEST_CASE("conflated messages", "[supervisor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto act = sup->create_actor<quotes_consumer_t>().timeout(rt::default_timeout).finish();
+
+    sup->do_process();
+    CHECK(act->prices == std::vector<int>{8, 9});
+    CHECK(sup->get_conflation_stats().messages == 10);
+    CHECK(sup->get_conflation_stats().conflated == 8);
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
@@ -83,3 +83,99 @@ TEST_CASE("ping-pong-pub-sub", "[supervisor]") {
     REQUIRE(sup->get_points().size() == 0);
     CHECK(rt::empty(sup->get_subscription()));
 }
+
+struct router_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        for (auto &addr : addresses) {
+            infos.emplace_back(subscribe(&router_t::on_payload, addr));
+        }
+    }
+
+    void on_payload(r::message_t<payload_t> &) noexcept { ++received; }
+
+    std::vector<r::address_ptr_t> addresses;
+    std::vector<r::subscription_info_ptr_t> infos;
+    std::size_t received = 0;
+};
+
+TEST_CASE("many subscriptions of single actor", "[supervisor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto router = sup->create_actor<router_t>().timeout(rt::default_timeout).finish();
+    for (std::size_t i = 0; i < 100; ++i) {
+        router->addresses.emplace_back(sup->create_address());
+    }
+    sup->do_process();
+    REQUIRE(router->access<rt::to::state>() == r::state_t::OPERATIONAL);
+
+    auto &identity = r::plugin::lifetime_plugin_t::class_identity;
+    auto lifetime = static_cast<r::plugin::lifetime_plugin_t *>(router->access<rt::to::get_plugin>(&identity));
+    auto &points = lifetime->access<rt::to::points>();
+    auto points_count = points.size();
+    for (std::size_t i = 0; i < router->addresses.size(); i += 2) {
+        lifetime->unsubscribe(router->infos[i]->handler, router->addresses[i]);
+    }
+    sup->do_process();
+    CHECK(points.size() == points_count - 50);
+
+    for (auto &addr : router->addresses) {
+        sup->send<payload_t>(addr);
+    }
+    sup->do_process();
+    CHECK(router->received == 50);
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+    REQUIRE(sup->get_points().size() == 0);
+    CHECK(rt::empty(sup->get_subscription()));
+}
+
+TEST_CASE("pub-sub, external subscribers are called in batch", "[supervisor]") {
+    r::system_context_t system_context;
+
+    const char locality1[] = "abc";
+    const char locality2[] = "def";
+    auto sup1 = system_context.create_supervisor<rt::supervisor_test_t>()
+                    .locality(locality1)
+                    .timeout(rt::default_timeout)
+                    .finish();
+    auto sup2 = sup1->create_actor<rt::supervisor_test_t>().locality(locality2).timeout(rt::default_timeout).finish();
+    auto pub_addr = sup1->create_address();
+
+    std::vector<r::intrusive_ptr_t<sub_t>> subs;
+    for (std::size_t i = 0; i < 5; ++i) {
+        subs.emplace_back(sup2->create_actor<sub_t>().pub_addr(pub_addr).timeout(rt::default_timeout).finish());
+    }
+    auto local_sub = sup1->create_actor<sub_t>().pub_addr(pub_addr).timeout(rt::default_timeout).finish();
+
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+    REQUIRE(sup1->get_state() == r::state_t::OPERATIONAL);
+    REQUIRE(sup2->get_state() == r::state_t::OPERATIONAL);
+
+    sup1->send<payload_t>(pub_addr);
+    sup1->do_process();
+    CHECK(local_sub->received == 1);
+    CHECK(sup2->get_leader_queue().size() == 1);
+
+    sup2->do_process();
+    for (auto &sub : subs) {
+        CHECK(sub->received == 1);
+    }
+
+    sup1->do_shutdown();
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+    REQUIRE(sup1->get_state() == r::state_t::SHUT_DOWN);
+    REQUIRE(sup2->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(rt::empty(sup1->get_subscription()));
+}
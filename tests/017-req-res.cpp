@@ -7,6 +7,7 @@
 #include "rotor.hpp"
 #include "supervisor_test.h"
 #include "access.h"
+#include <thread>
 
 namespace r = rotor;
 namespace rt = r::test;
@@ -442,6 +443,44 @@ struct order_actor_t : r::actor_base_t {
     int order;
 };
 
+struct copy_counting_res_t {
+    static inline int copies = 0;
+    int value = 0;
+
+    copy_counting_res_t() = default;
+    copy_counting_res_t(int value_) : value{value_} {}
+    copy_counting_res_t(const copy_counting_res_t &other) : value{other.value} { ++copies; }
+    copy_counting_res_t(copy_counting_res_t &&other) = default;
+    copy_counting_res_t &operator=(const copy_counting_res_t &) = default;
+};
+
+struct copy_counting_req_t {
+    using response_t = copy_counting_res_t;
+};
+
+using cc_traits_t = r::request_traits_t<copy_counting_req_t>;
+
+struct zero_copy_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+    int res_val = 0;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&zero_copy_actor_t::on_request);
+            p.subscribe_actor(&zero_copy_actor_t::on_response);
+        });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        request<copy_counting_req_t>(address).send(r::pt::seconds(1));
+    }
+
+    void on_request(cc_traits_t::request::message_t &msg) noexcept { reply_to(msg, 7); }
+
+    void on_response(cc_traits_t::response::message_t &msg) noexcept { res_val += msg.payload.res.value; }
+};
+
 TEST_CASE("request-response successful delivery", "[actor]") {
     r::system_context_t system_context;
 
@@ -807,3 +846,339 @@ TEST_CASE("response and regular messages keep send order", "[actor]") {
     sup->do_process();
     REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
 }
+
+TEST_CASE("response payload is not copied", "[actor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto act = sup->create_actor<zero_copy_actor_t>().timeout(rt::default_timeout).finish();
+    copy_counting_res_t::copies = 0;
+    sup->do_process();
+
+    CHECK(act->res_val == 7);
+    CHECK(copy_counting_res_t::copies == 0);
+    CHECK(sup->get_requests().size() == 0);
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+}
+
+struct expiring_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+    int requests = 0;
+    int responses = 0;
+    int notifications = 0;
+    r::extended_error_ptr_t ee;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&expiring_actor_t::on_request);
+            p.subscribe_actor(&expiring_actor_t::on_response);
+            p.subscribe_actor(&expiring_actor_t::on_notify);
+        });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        request<request_sample_t>(address, 4).ttl(r::pt::microseconds(0)).send(r::pt::seconds(1));
+        send<notify_t>(r::pt::microseconds(0), address);
+        send<notify_t>(r::pt::minutes(1), address);
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept {
+        ++requests;
+        reply_to(msg, 5);
+    }
+
+    void on_response(traits_t::response::message_t &msg) noexcept {
+        ++responses;
+        ee = msg.payload.ee;
+    }
+
+    void on_notify(notify_msg_t &) noexcept { ++notifications; }
+};
+
+TEST_CASE("expired messages are dropped, expired request is replied with timeout", "[actor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto act = sup->create_actor<expiring_actor_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+
+    CHECK(act->requests == 0);
+    CHECK(act->responses == 1);
+    REQUIRE(act->ee);
+    CHECK(act->ee->ec == r::error_code_t::request_timeout);
+    CHECK(act->notifications == 1);
+    CHECK(sup->get_requests().size() == 0);
+    CHECK(sup->active_timers.size() == 0);
+    CHECK(sup->get_expiry_stats().messages == 2);
+    CHECK(sup->get_expiry_stats().requests == 1);
+
+    sup->do_shutdown();
+    sup->do_process();
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("request timeouts wheel", "[supervisor]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>()
+                   .timeout(rt::default_timeout)
+                   .request_tick(r::pt::milliseconds{1})
+                   .finish();
+    sup->do_process();
+    auto tick_timer = [&]() { return sup->active_timers.empty() ? 0 : sup->get_timer(0); };
+
+    SECTION("responses do not touch backend timers") {
+        auto act = sup->create_actor<good_actor_t>().timeout(rt::default_timeout).finish();
+        sup->do_process();
+        CHECK(act->res_val == 5);
+        CHECK(sup->get_requests().size() == 0);
+        // the only (periodic) timer for the all requests
+        CHECK(sup->active_timers.size() == 1);
+        auto timer_id = tick_timer();
+        sup->do_invoke_timer(timer_id);
+        // nothing to wait, the tick is not restarted
+        CHECK(sup->active_timers.size() == 0);
+    }
+
+    SECTION("timed out request") {
+        auto act = sup->create_actor<bad_actor_t>().timeout(rt::default_timeout).finish();
+        sup->do_process();
+        CHECK(act->req_msg);
+        CHECK(sup->get_requests().size() == 1);
+        REQUIRE(sup->active_timers.size() == 1);
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        sup->do_invoke_timer(tick_timer());
+        sup->do_process();
+        REQUIRE(act->ee);
+        CHECK(act->ee->ec == r::error_code_t::request_timeout);
+        CHECK(sup->get_requests().size() == 0);
+        CHECK(sup->active_timers.size() == 0);
+
+        act->reply_to(*act->req_msg, 1);
+        sup->do_process();
+        CHECK(act->res_val == 0);
+    }
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup->get_leader_queue().size() == 0);
+    CHECK(sup->active_timers.size() == 0);
+}
+
+using all_msg_t = traits_t::all_response::message_t;
+using any_msg_t = traits_t::any_response::message_t;
+using cancel_msg_t = traits_t::cancel::message_t;
+
+struct shard_actor_t : public r::actor_base_t {
+    enum class reply_t { value, error, none };
+
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&shard_actor_t::on_request);
+            p.subscribe_actor(&shard_actor_t::on_cancel);
+        });
+    }
+
+    void shutdown_start() noexcept override {
+        req_msg.reset();
+        r::actor_base_t::shutdown_start();
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept {
+        if (reply == reply_t::value) {
+            reply_to(msg, msg.payload.request_payload.value + factor);
+        } else if (reply == reply_t::error) {
+            reply_with_error(msg, make_error(r::make_error_code(r::error_code_t::request_timeout)));
+        } else {
+            req_msg.reset(&msg);
+        }
+    }
+
+    void on_cancel(cancel_msg_t &msg) noexcept {
+        ++cancellations;
+        if (req_msg && req_msg->payload.id == msg.payload.id && req_msg->payload.origin == msg.payload.source) {
+            reply_with_error(*req_msg, make_error(r::make_error_code(r::error_code_t::cancelled)));
+            req_msg.reset();
+        }
+    }
+
+    reply_t reply = reply_t::value;
+    int factor = 0;
+    int cancellations = 0;
+    req_ptr_t req_msg;
+};
+
+struct gatherer_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&gatherer_actor_t::on_all);
+            p.subscribe_actor(&gatherer_actor_t::on_any);
+        });
+    }
+
+    void on_all(all_msg_t &msg) noexcept {
+        ++received;
+        all.reset(&msg);
+    }
+
+    void on_any(any_msg_t &msg) noexcept {
+        ++received;
+        any.reset(&msg);
+    }
+
+    int received = 0;
+    r::intrusive_ptr_t<all_msg_t> all;
+    r::intrusive_ptr_t<any_msg_t> any;
+};
+
+TEST_CASE("scattered requests", "[actor]") {
+    using reply_t = shard_actor_t::reply_t;
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto act = sup->create_actor<gatherer_actor_t>().timeout(rt::default_timeout).finish();
+    std::vector<r::intrusive_ptr_t<shard_actor_t>> shards;
+    std::vector<r::address_ptr_t> addresses;
+    for (int i = 0; i < 3; ++i) {
+        auto shard = sup->create_actor<shard_actor_t>().timeout(rt::default_timeout).finish();
+        shard->factor = (i + 1) * 10;
+        addresses.push_back(shard->get_address());
+        shards.emplace_back(std::move(shard));
+    }
+    sup->do_process();
+    REQUIRE(sup->active_timers.size() == 0);
+
+    SECTION("all responses are gathered") {
+        shards[1]->reply = reply_t::error;
+        auto id = act->request_all<request_sample_t>(addresses, 1).send(rt::default_timeout);
+        CHECK(sup->get_requests().size() == 1);
+        CHECK(sup->active_timers.size() == 1);
+        sup->do_process();
+
+        CHECK(act->received == 1);
+        REQUIRE(act->all);
+        auto &payload = act->all->payload;
+        CHECK(payload.request_id() == id);
+        CHECK(!payload.ee);
+        REQUIRE(payload.responses.size() == 3);
+        CHECK(payload.responses[0]->payload.res.value == 11);
+        CHECK(payload.responses[1]->payload.ee);
+        CHECK(payload.responses[2]->payload.res.value == 31);
+        CHECK(payload.responses[2]->payload.req == payload.requests[2]);
+        CHECK(payload.requests[2]->address == addresses[2]);
+        CHECK(sup->get_requests().size() == 0);
+        CHECK(sup->active_timers.size() == 0);
+    }
+
+    SECTION("all responses, timeout") {
+        shards[1]->reply = reply_t::none;
+        act->request_all<request_sample_t>(addresses, 1).send(rt::default_timeout);
+        sup->do_process();
+        CHECK(act->received == 0);
+        REQUIRE(sup->active_timers.size() == 1);
+
+        sup->do_invoke_timer(sup->get_timer(0));
+        sup->do_process();
+        CHECK(act->received == 1);
+        REQUIRE(act->all);
+        auto &payload = act->all->payload;
+        REQUIRE(payload.ee);
+        CHECK(payload.ee->ec == r::error_code_t::request_timeout);
+        CHECK(payload.responses[0]);
+        CHECK(!payload.responses[1]);
+        CHECK(payload.responses[2]);
+        CHECK(sup->get_requests().size() == 0);
+
+        // unanswered request is cancelled, its late (error) response is dropped
+        CHECK(shards[0]->cancellations == 0);
+        CHECK(shards[1]->cancellations == 1);
+        CHECK(!shards[1]->req_msg);
+        CHECK(shards[2]->cancellations == 0);
+        CHECK(act->received == 1);
+        CHECK(!act->all->payload.responses[1]);
+    }
+
+    SECTION("first successful response wins, the rest are cancelled") {
+        shards[0]->reply = reply_t::none;
+        shards[1]->reply = reply_t::error;
+        auto id = act->request_any<request_sample_t>(addresses, 2).send(rt::default_timeout);
+        sup->do_process();
+
+        CHECK(act->received == 1);
+        REQUIRE(act->any);
+        auto &payload = act->any->payload;
+        CHECK(payload.request_id() == id);
+        CHECK(!payload.ee);
+        REQUIRE(payload.response);
+        CHECK(payload.response->payload.res.value == 32);
+        CHECK(payload.responses[1]->payload.ee);
+        CHECK(!payload.responses[0]);
+
+        CHECK(shards[0]->cancellations == 1);
+        CHECK(!shards[0]->req_msg);
+        CHECK(shards[1]->cancellations == 0);
+        CHECK(shards[2]->cancellations == 0);
+        CHECK(sup->get_requests().size() == 0);
+        CHECK(sup->active_timers.size() == 0);
+    }
+
+    SECTION("any response, all failed") {
+        for (auto &shard : shards) {
+            shard->reply = reply_t::error;
+        }
+        act->request_any<request_sample_t>(addresses, 2).send(rt::default_timeout);
+        sup->do_process();
+
+        CHECK(act->received == 1);
+        REQUIRE(act->any);
+        auto &payload = act->any->payload;
+        REQUIRE(payload.ee);
+        CHECK(payload.ee == payload.responses[2]->payload.ee);
+        CHECK(!payload.response);
+        CHECK(sup->get_requests().size() == 0);
+        CHECK(sup->active_timers.size() == 0);
+    }
+
+    SECTION("any response, timeout") {
+        shards[0]->reply = reply_t::none;
+        shards[1]->reply = reply_t::none;
+        shards[2]->reply = reply_t::error;
+        act->request_any<request_sample_t>(addresses, 2).send(rt::default_timeout);
+        sup->do_process();
+        CHECK(act->received == 0);
+
+        sup->do_invoke_timer(sup->get_timer(0));
+        sup->do_process();
+        REQUIRE(act->any);
+        auto &payload = act->any->payload;
+        REQUIRE(payload.ee);
+        CHECK(payload.ee->ec == r::error_code_t::request_timeout);
+        CHECK(!payload.response);
+        CHECK(payload.responses[2]);
+        CHECK(sup->get_requests().size() == 0);
+
+        CHECK(shards[0]->cancellations == 1);
+        CHECK(shards[1]->cancellations == 1);
+        CHECK(shards[2]->cancellations == 0);
+        CHECK(act->received == 1);
+    }
+
+    act.reset();
+    shards.clear();
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup->get_leader_queue().size() == 0);
+    CHECK(sup->get_requests().size() == 0);
+    CHECK(sup->active_timers.size() == 0);
+}
@@ -187,3 +187,53 @@ TEST_CASE("pinger & ponger on different supervisors, self controlled", "[supervi
     CHECK(sup1->get_points().size() == 0);
     REQUIRE(rt::empty(sup1->get_subscription()));
 }
+
+TEST_CASE("batched hand-off to the foreign locality", "[supervisor]") {
+    r::system_context_t system_context;
+
+    const char locality1[] = "l1";
+    const char locality2[] = "l2";
+    auto sup1 = system_context.create_supervisor<rt::supervisor_test_t>()
+                    .locality(locality1)
+                    .timeout(rt::default_timeout)
+                    .finish();
+    auto sup2 = sup1->create_actor<rt::supervisor_test_t>().locality(locality2).timeout(rt::default_timeout).finish();
+
+    auto pinger = sup1->create_actor<pinger_t>().timeout(rt::default_timeout).finish();
+    auto ponger = sup2->create_actor<ponger_t>().timeout(rt::default_timeout).finish();
+
+    pinger->set_ponger_addr(ponger->get_address());
+    ponger->set_pinger_addr(pinger->get_address());
+
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+
+    auto stats1 = sup1->get_handoff_stats();
+    for (int i = 0; i < 10; ++i) {
+        pinger->do_send_ping();
+    }
+    sup1->do_process();
+    CHECK(sup1->get_handoff_stats().wakeups == stats1.wakeups + 1);
+    CHECK(sup1->get_handoff_stats().messages == stats1.messages + 10);
+    CHECK(sup2->get_leader_queue().size() == 10);
+
+    auto stats2 = sup2->get_handoff_stats();
+    sup2->do_process();
+    CHECK(ponger->ping_received == 10);
+    CHECK(sup2->get_handoff_stats().wakeups == stats2.wakeups + 1);
+    CHECK(sup2->get_handoff_stats().messages == stats2.messages + 10);
+    CHECK(sup2->get_handoff_stats().messages_per_wakeup() > 1.0);
+
+    sup1->do_process();
+    CHECK(pinger->pong_received == 10);
+
+    sup1->do_shutdown();
+    while (!sup1->get_leader_queue().empty() || !sup2->get_leader_queue().empty()) {
+        sup1->do_process();
+        sup2->do_process();
+    }
+    CHECK(sup2->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup1->get_state() == r::state_t::SHUT_DOWN);
+}
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor.hpp"
+#include "supervisor_test.h"
+#include <thread>
+
+namespace r = rotor;
+namespace rt = r::test;
+
+struct sample_t {
+    int value;
+};
+
+struct big_t {
+    char data[4096];
+};
+
+struct ping_t {};
+struct pong_t {};
+
+struct ponger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&ponger_t::on_ping); });
+    }
+
+    void on_ping(r::message_t<ping_t> &) noexcept {
+        ++pings;
+        send<pong_t>(pinger_addr);
+    }
+
+    std::uint32_t pings = 0;
+    r::address_ptr_t pinger_addr;
+};
+
+struct pinger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&pinger_t::on_pong); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        send<ping_t>(ponger_addr);
+    }
+
+    void on_pong(r::message_t<pong_t> &) noexcept {
+        if (++pongs < 100) {
+            send<ping_t>(ponger_addr);
+        }
+    }
+
+    std::uint32_t pongs = 0;
+    r::address_ptr_t ponger_addr;
+};
+
+TEST_CASE("message pool hits & misses", "[message]") {
+    auto pool = r::message_pool_ptr_t(new r::message_pool_t(2));
+    r::message_support::pool_guard_t guard(pool.get());
+
+    auto m1 = r::make_message<sample_t>(r::address_ptr_t{}, 1);
+    CHECK(pool->misses() == 1);
+    CHECK(pool->hits() == 0);
+    m1.reset();
+
+    auto m2 = r::make_message<sample_t>(r::address_ptr_t{}, 2);
+    CHECK(pool->misses() == 1);
+    CHECK(pool->hits() == 1);
+
+    auto m3 = r::make_message<big_t>(r::address_ptr_t{});
+    CHECK(pool->misses() == 2);
+    CHECK(pool->hits() == 1);
+}
+
+TEST_CASE("message pool, foreign release", "[message]") {
+    auto pool = r::message_pool_ptr_t(new r::message_pool_t(2));
+    auto message = r::make_message<sample_t>(pool.get(), r::address_ptr_t{}, 1);
+    CHECK(pool->misses() == 1);
+
+    std::thread thread([&]() { message.reset(); });
+    thread.join();
+
+    r::message_support::pool_guard_t guard(pool.get());
+    auto m2 = r::make_message<sample_t>(r::address_ptr_t{}, 2);
+    CHECK(pool->misses() == 1);
+    CHECK(pool->hits() == 1);
+}
+
+TEST_CASE("message outlives pool", "[message]") {
+    auto pool = r::message_pool_ptr_t(new r::message_pool_t(2));
+    auto m1 = r::make_message<sample_t>(pool.get(), r::address_ptr_t{}, 1);
+    auto m2 = r::make_message<sample_t>(pool.get(), r::address_ptr_t{}, 2);
+    pool.reset();
+    m1.reset();
+    std::thread thread([&]() { m2.reset(); });
+    thread.join();
+    CHECK(!m2);
+}
+
+TEST_CASE("supervisor with message pool", "[message][supervisor]") {
+    r::system_context_t system_context;
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>()
+                   .timeout(rt::default_timeout)
+                   .message_pool_size(16)
+                   .finish();
+    auto pinger = sup->create_actor<pinger_t>().timeout(rt::default_timeout).finish();
+    auto ponger = sup->create_actor<ponger_t>().timeout(rt::default_timeout).finish();
+    pinger->ponger_addr = ponger->get_address();
+    ponger->pinger_addr = pinger->get_address();
+
+    auto pool = sup->get_message_pool();
+    REQUIRE(pool);
+
+    sup->do_process();
+    CHECK(pinger->pongs == 100);
+    CHECK(ponger->pings == 100);
+    CHECK(pool->hits() > pool->misses());
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+}
@@ -5,9 +5,16 @@
 //
 
 #include "rotor.hpp"
+#include "rotor/detail/timer_heap.h"
+#include "rotor/detail/timer_wheel.h"
+#include "rotor/detail/request_table.h"
+#include "supervisor_test.h"
 #include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
 
 namespace r = rotor;
+namespace rt = r::test;
 
 TEST_CASE("error code messages", "[misc]") {
     CHECK(r::error_code_category().name() == std::string("rotor_error"));
@@ -16,3 +23,403 @@ TEST_CASE("error code messages", "[misc]") {
     CHECK(r::shutdown_code_category().name() == std::string("rotor_shutdown"));
     CHECK(r::shutdown_code_category().message(-1) == "unknown shutdown reason");
 }
+
+TEST_CASE("message type ids", "[misc]") {
+    struct a_t {};
+    struct b_t {};
+    using namespace r::message_support;
+    auto id_a = type_id(r::message_t<a_t>::message_type);
+    auto id_b = type_id(r::message_t<b_t>::message_type);
+    CHECK(id_a != id_b);
+    CHECK(type_id(register_type(typeid(r::message_t<a_t>))) == id_a);
+    CHECK(register_type(typeid(r::message_t<b_t>)) == r::message_t<b_t>::message_type);
+    CHECK(type_name(r::message_t<a_t>::message_type) == std::string(typeid(r::message_t<a_t>).name()));
+}
+
+TEST_CASE("inbound queue", "[misc]") {
+    struct sample_t {
+        int producer;
+        int value;
+    };
+    using message_t = r::message_t<sample_t>;
+    r::inbound_queue_t inbound;
+    r::messages_queue_t queue;
+    CHECK(inbound.empty());
+    CHECK(!inbound.pop_all());
+
+    SECTION("fifo order") {
+        for (int i = 0; i < 3; ++i) {
+            auto was_empty = inbound.push(r::make_message<sample_t>(r::address_ptr_t{}, 0, i).detach());
+            CHECK(was_empty == (i == 0));
+        }
+        CHECK(!inbound.empty());
+        CHECK(inbound.drain(queue) == 3);
+        CHECK(inbound.empty());
+        REQUIRE(queue.size() == 3);
+        for (int i = 0; i < 3; ++i) {
+            CHECK(static_cast<message_t &>(*queue[i]).payload.value == i);
+        }
+    }
+
+    SECTION("multiple producers") {
+        static constexpr int producers = 4;
+        static constexpr int count = 10000;
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&inbound, p]() {
+                for (int i = 0; i < count; ++i) {
+                    inbound.push(r::make_message<sample_t>(r::address_ptr_t{}, p, i).detach());
+                }
+            });
+        }
+        int last[producers] = {-1, -1, -1, -1};
+        std::size_t total = 0;
+        while (total < producers * count) {
+            total += inbound.drain(queue);
+            for (auto &message : queue) {
+                auto &payload = static_cast<message_t &>(*message).payload;
+                CHECK(payload.value == last[payload.producer] + 1);
+                last[payload.producer] = payload.value;
+            }
+            queue.clear();
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        CHECK(inbound.empty());
+    }
+
+    SECTION("pending messages are released") {
+        inbound.push(r::make_message<sample_t>(r::address_ptr_t{}, 0, 0).detach());
+    }
+}
+
+struct urgent_t {
+    static constexpr r::message_priority_t priority = r::message_priority_t::high;
+    int value;
+};
+
+struct quote_t {
+    static constexpr bool conflate = true;
+    std::uint64_t conflation_key() const noexcept { return symbol; }
+    std::uint64_t symbol;
+    int price;
+};
+
+TEST_CASE("message lanes", "[misc]") {
+    struct sample_t {
+        int value;
+    };
+    using message_t = r::message_t<sample_t>;
+    using urgent_message_t = r::message_t<urgent_t>;
+    auto value_of = [](const r::message_ptr_t &message) {
+        if (message->type_index == urgent_message_t::message_type) {
+            return static_cast<urgent_message_t &>(*message).payload.value;
+        }
+        return static_cast<message_t &>(*message).payload.value;
+    };
+    auto make = [](int value, r::message_priority_t priority) {
+        auto message = r::make_message<sample_t>(r::address_ptr_t{}, value);
+        message->priority = priority;
+        return message;
+    };
+
+    r::message_lanes_t queue;
+    CHECK(queue.empty());
+
+    SECTION("priority is defined by payload type") {
+        CHECK(r::make_message<sample_t>(r::address_ptr_t{}, 0)->priority == r::message_priority_t::normal);
+        CHECK(r::make_message<urgent_t>(r::address_ptr_t{}, 0)->priority == r::message_priority_t::high);
+        CHECK(r::make_message<r::payload::shutdown_trigger_t>(r::address_ptr_t{}, r::address_ptr_t{},
+                                                              r::extended_error_ptr_t{})
+                  ->priority == r::message_priority_t::normal);
+    }
+
+    SECTION("higher lanes first, fifo within lane") {
+        queue.push_back(make(1, r::message_priority_t::low));
+        queue.push_back(make(2, r::message_priority_t::normal));
+        queue.push_back(make(3, r::message_priority_t::low));
+        queue.push_back(r::make_message<urgent_t>(r::address_ptr_t{}, 4));
+        queue.push_back(make(5, r::message_priority_t::normal));
+        CHECK(value_of(queue.back()) == 5);
+        REQUIRE(queue.size() == 5);
+        CHECK(queue.lane(r::message_priority_t::low).size() == 2);
+
+        std::vector<int> order;
+        while (!queue.empty()) {
+            order.push_back(value_of(queue.front()));
+            auto message = queue.pop();
+            CHECK(value_of(message) == order.back());
+        }
+        CHECK(order == std::vector<int>{4, 2, 5, 1, 3});
+    }
+
+    SECTION("lower lanes do not starve") {
+        queue.push_back(make(-1, r::message_priority_t::low));
+        int high = 0;
+        while (queue.lane(r::message_priority_t::low).size()) {
+            queue.push_back(make(high++, r::message_priority_t::high));
+            queue.push_back(make(high++, r::message_priority_t::high));
+            queue.pop();
+        }
+        CHECK(high <= 2 * static_cast<int>(r::message_lanes_t::max_skips + 1));
+        queue.clear();
+        CHECK(queue.empty());
+    }
+
+    SECTION("drain from inbound queue") {
+        r::inbound_queue_t inbound;
+        inbound.push(make(1, r::message_priority_t::low).detach());
+        inbound.push(make(2, r::message_priority_t::high).detach());
+        CHECK(inbound.drain(queue) == 2);
+        CHECK(value_of(queue.front()) == 2);
+    }
+
+    SECTION("conflation") {
+        using quote_message_t = r::message_t<quote_t>;
+        r::system_context_t system_context;
+        auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+        auto addr_1 = sup->make_address();
+        auto addr_2 = sup->make_address();
+        auto price_of = [](const r::message_ptr_t &message) {
+            return static_cast<quote_message_t &>(*message).payload.price;
+        };
+        auto quote = r::make_message<quote_t>(addr_1, 1u, 10);
+        CHECK(quote->conflatable);
+        CHECK(quote->conflation_key == 1);
+        CHECK(!make(0, r::message_priority_t::normal)->conflatable);
+
+        r::inbound_queue_t inbound;
+        inbound.push(quote.detach());
+        inbound.push(r::make_message<quote_t>(addr_1, 2u, 20).detach());
+        inbound.push(make(0, r::message_priority_t::normal).detach());
+        inbound.push(r::make_message<quote_t>(addr_1, 1u, 11).detach());
+        inbound.push(r::make_message<quote_t>(addr_2, 1u, 30).detach());
+        CHECK(inbound.drain(queue) == 5);
+        queue.push_back(r::make_message<quote_t>(addr_1, 1u, 12));
+        queue.push_back(r::make_message<quote_t>(addr_1, 2u, 21));
+
+        REQUIRE(queue.size() == 4);
+        CHECK(queue.get_conflation_stats().messages == 6);
+        CHECK(queue.get_conflation_stats().conflated == 3);
+
+        CHECK(price_of(queue.front()) == 12);
+        queue.pop_front();
+        queue.push_back(r::make_message<quote_t>(addr_1, 1u, 13));
+        CHECK(queue.size() == 4);
+        CHECK(price_of(queue.pop()) == 21);
+        queue.push_back(r::make_message<quote_t>(addr_1, 2u, 22));
+        CHECK(queue.size() == 4);
+
+        std::vector<int> prices;
+        while (!queue.empty()) {
+            auto message = queue.pop();
+            prices.push_back(message->conflatable ? price_of(message) : -1);
+        }
+        CHECK(prices == std::vector<int>{-1, 30, 13, 22});
+        CHECK(queue.get_conflation_stats().conflated == 3);
+
+        // the uplifted message remains conflatable at its new place
+        queue.push_back(r::make_message<quote_t>(addr_1, 1u, 14));
+        queue.push_back(r::make_message<quote_t>(addr_2, 1u, 31));
+        queue.push_front(queue.pop_back());
+        queue.push_back(r::make_message<quote_t>(addr_2, 1u, 32));
+        REQUIRE(queue.size() == 2);
+        CHECK(queue.get_conflation_stats().conflated == 4);
+        CHECK(price_of(queue.pop()) == 32);
+        CHECK(price_of(queue.pop()) == 14);
+
+        sup->do_process();
+        sup->do_shutdown();
+        sup->do_process();
+        CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+    }
+}
+
+TEST_CASE("timer heap", "[misc]") {
+    struct handler_t : r::timer_handler_base_t {
+        using r::timer_handler_base_t::timer_handler_base_t;
+        void trigger(bool) noexcept override {}
+    };
+    using heap_t = r::detail::timer_heap_t<int>;
+
+    std::vector<std::unique_ptr<handler_t>> handlers;
+    heap_t heap;
+    for (r::request_id_t i = 0; i < 1000; ++i) {
+        handlers.emplace_back(new handler_t(nullptr, i));
+        heap.push(*handlers.back(), static_cast<int>((i * 7919) % 97));
+    }
+    CHECK(heap.size() == 1000);
+
+    for (std::size_t i = 0; i < handlers.size(); i += 3) {
+        heap.erase(*handlers[i]);
+        CHECK(handlers[i]->queue_index == r::timer_handler_base_t::npos);
+    }
+
+    int last_deadline = -1;
+    r::request_id_t last_id = 0;
+    std::size_t count = 0;
+    while (!heap.empty()) {
+        auto deadline = heap.top().deadline;
+        auto handler = heap.pop();
+        CHECK(handler->request_id % 3 != 0);
+        CHECK(deadline >= last_deadline);
+        if (deadline == last_deadline) {
+            CHECK(handler->request_id > last_id);
+        }
+        last_deadline = deadline;
+        last_id = handler->request_id;
+        ++count;
+    }
+    CHECK(count == 666);
+}
+
+TEST_CASE("timer wheel", "[misc]") {
+    using time_point_t = std::chrono::steady_clock::time_point;
+    using wheel_t = r::detail::timer_wheel_t<time_point_t, 16>;
+    using ms_t = std::chrono::milliseconds;
+    struct node_t {
+        r::detail::wheel_hook_t hook;
+        time_point_t deadline;
+    };
+
+    auto origin = time_point_t{};
+    wheel_t wheel(ms_t{10}, origin);
+    std::vector<node_t> nodes(1000);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        auto &node = nodes[i];
+        node.hook.id = i;
+        node.deadline = origin + ms_t{(i * 7919) % 997};
+        wheel.push(node.hook, node.deadline);
+    }
+    CHECK(wheel.size() == 1000);
+
+    for (std::size_t i = 0; i < nodes.size(); i += 3) {
+        wheel.erase(nodes[i].hook);
+        CHECK(!nodes[i].hook.tick);
+    }
+    CHECK(wheel.size() == 666);
+
+    std::size_t count = 0;
+    auto now = origin;
+    SECTION("small steps") {
+        while (!wheel.empty()) {
+            now += ms_t{13};
+            wheel.advance(now, [&](r::detail::wheel_hook_t &hook) {
+                auto &node = nodes[hook.id];
+                CHECK(hook.id % 3 != 0);
+                CHECK(!hook.tick);
+                CHECK(node.deadline <= now);
+                CHECK(node.deadline + ms_t{23} > now);
+                ++count;
+            });
+        }
+    }
+    SECTION("one step") {
+        now += ms_t{2000};
+        count = wheel.advance(now, [&](r::detail::wheel_hook_t &hook) { CHECK(hook.id % 3 != 0); });
+        CHECK(wheel.empty());
+    }
+    CHECK(count == 666);
+
+    // never expires in the past
+    node_t late;
+    late.hook.id = 1;
+    wheel.push(late.hook, origin);
+    CHECK(wheel.advance(now, [](auto &) {}) == 0);
+    CHECK(wheel.advance(now + ms_t{10}, [](auto &) {}) == 1);
+}
+
+TEST_CASE("request table", "[misc]") {
+    using table_t = r::detail::request_table_t;
+    using list_t = r::detail::request_list_t;
+    auto make_curry = []() { return r::request_curry_t{nullptr, r::address_ptr_t{}, r::message_ptr_t{}, nullptr}; };
+
+    table_t table;
+    list_t list_a, list_b;
+    std::vector<r::request_id_t> ids_a, ids_b;
+    for (int i = 0; i < 10; ++i) {
+        ids_a.push_back(table.emplace(make_curry(), list_a));
+        ids_b.push_back(table.emplace(make_curry(), list_b));
+    }
+    CHECK(table.size() == 20);
+    CHECK(list_a.size() == 10);
+    CHECK(list_b.size() == 10);
+    CHECK(list_a.front() == ids_a.back());
+    for (auto id : ids_a) {
+        CHECK(table.contains(id));
+        CHECK(table.find(id));
+        // never clashes with timer ids
+        CHECK(id >> (std::numeric_limits<r::request_id_t>::digits - 1));
+    }
+
+    // erase from the middle, from the head
+    table.erase(ids_a[4]);
+    table.erase(ids_a[9]);
+    CHECK(!table.find(ids_a[4]));
+    CHECK(list_a.size() == 8);
+    CHECK(list_a.front() == ids_a[8]);
+
+    // slot is reused, but stale id is not recognized
+    auto id = table.emplace(make_curry(), list_b);
+    CHECK(id != ids_a[9]);
+    CHECK(id != ids_a[4]);
+    CHECK(!table.contains(ids_a[9]));
+    CHECK(!table.contains(ids_a[4]));
+    CHECK(table.size() == 19);
+    CHECK(list_b.front() == id);
+
+    while (!list_a.empty()) {
+        table.erase(list_a.front());
+    }
+    while (!list_b.empty()) {
+        table.erase(list_b.front());
+    }
+    CHECK(table.empty());
+    for (auto id : ids_b) {
+        CHECK(!table.contains(id));
+    }
+}
+
+#if defined(ROTOR_REFCOUNT_HYBRID)
+TEST_CASE("hybrid refcount, nested messages sharing", "[misc]") {
+    struct sample_t {};
+    auto orig = r::make_message<sample_t>(r::address_ptr_t{});
+    auto call = r::make_message<r::payload::handler_call_t>(r::address_ptr_t{}, orig, r::handler_ptr_t{});
+    CHECK(!orig->is_shared());
+    CHECK(!call->is_shared());
+
+    auto copy = call;
+    CHECK(call->use_count() == 2);
+
+    call->share();
+    CHECK(call->is_shared());
+    CHECK(orig->is_shared());
+    CHECK(call->use_count() == 2);
+    CHECK(orig->use_count() == 2);
+}
+
+TEST_CASE("hybrid refcount, gathered response sharing", "[misc]") {
+    struct res_t {};
+    struct req_t {
+        using response_t = res_t;
+    };
+    using traits_t = r::request_traits_t<req_t>;
+    auto addr = r::address_ptr_t{};
+    auto req_raw = new traits_t::request::message_t(addr, r::request_id_t{1}, addr, addr);
+    auto req = traits_t::request::message_ptr_t(req_raw);
+    auto res_raw = new traits_t::response::message_t(addr, r::extended_error_ptr_t{}, req);
+    auto res = traits_t::response::message_ptr_t(res_raw);
+    auto gathered = traits_t::any_response::message_ptr_t(new traits_t::any_response::message_t(addr));
+    gathered->payload.requests.emplace_back(req);
+    gathered->payload.responses.emplace_back(res);
+    gathered->payload.response = res;
+    CHECK(!req->is_shared());
+    CHECK(!res->is_shared());
+
+    gathered->share();
+    CHECK(gathered->is_shared());
+    CHECK(req->is_shared());
+    CHECK(res->is_shared());
+}
+#endif
@@ -95,6 +95,39 @@ TEST_CASE("ping/pong ", "[supervisor][asio]") {
     ponger.reset();
 
     io_context.run();
-    CHECK(sup->get_timers_map().size() == 0);
+    CHECK(sup->get_timers_queue().size() == 0);
     CHECK(destroyed == 4);
 }
+
+TEST_CASE("wake-up coalescing", "[supervisor][asio]") {
+    asio::io_context io_context{1};
+    auto system_context = ra::system_context_asio_t::ptr_t{new ra::system_context_asio_t(io_context)};
+    auto strand = std::make_shared<asio::io_context::strand>(io_context);
+    auto timeout = r::pt::milliseconds{10};
+    auto sup = system_context->create_supervisor<rt::supervisor_asio_test_t>().timeout(timeout).strand(strand).finish();
+
+    auto ponger = sup->create_actor<ponger_t>().timeout(timeout).finish();
+    ponger->set_pinger_addr(sup->get_address());
+
+    sup->start();
+    io_context.poll();
+    REQUIRE(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::OPERATIONAL);
+
+    auto &ponger_addr = static_cast<r::actor_base_t *>(ponger.get())->get_address();
+    for (int i = 0; i < 50; ++i) {
+        sup->enqueue(r::make_message<ping_t>(ponger_addr));
+    }
+    io_context.restart();
+    CHECK(io_context.poll() == 1);
+    CHECK(ponger->ping_received == 50);
+
+    sup->enqueue(r::make_message<ping_t>(ponger_addr));
+    io_context.restart();
+    CHECK(io_context.poll() == 1);
+    CHECK(ponger->ping_received == 51);
+
+    sup->shutdown();
+    io_context.restart();
+    io_context.run();
+    REQUIRE(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
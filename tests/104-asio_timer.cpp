@@ -68,3 +68,54 @@ TEST_CASE("timer", "[supervisor][asio]") {
     REQUIRE(sup->get_leader_queue().size() == 0);
     CHECK(rt::empty(sup->get_subscription()));
 }
+
+struct timers_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+    std::vector<int> fired;
+    int cancelled = 0;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        auto t3 = start_timer(r::pt::milliseconds(3), *this, &timers_actor_t::on_timer_3);
+        start_timer(r::pt::milliseconds(2), *this, &timers_actor_t::on_timer_2);
+        start_timer(r::pt::milliseconds(1), *this, &timers_actor_t::on_timer_1);
+        auto t0 = start_timer(r::pt::microseconds(1), *this, &timers_actor_t::on_timer_1);
+        cancel_timer(t0);
+        cancel_timer(t3);
+    }
+
+    void on_timer_1(r::request_id_t, bool cancel) noexcept { on_timer(1, cancel); }
+    void on_timer_2(r::request_id_t, bool cancel) noexcept { on_timer(2, cancel); }
+    void on_timer_3(r::request_id_t, bool cancel) noexcept { on_timer(3, cancel); }
+
+    void on_timer(int value, bool cancel) noexcept {
+        if (cancel) {
+            ++cancelled;
+            return;
+        }
+        fired.push_back(value);
+        if (fired.size() == 2) {
+            supervisor->do_shutdown();
+        }
+    }
+};
+
+TEST_CASE("multiple timers, single native timer", "[supervisor][asio]") {
+    asio::io_context io_context{1};
+    auto timeout = r::pt::milliseconds{10};
+    auto system_context = ra::system_context_asio_t::ptr_t{new ra::system_context_asio_t(io_context)};
+    auto strand = std::make_shared<asio::io_context::strand>(io_context);
+
+    auto sup = system_context->create_supervisor<rt::supervisor_asio_test_t>().strand(strand).timeout(timeout).finish();
+    auto actor = sup->create_actor<timers_actor_t>().timeout(timeout).finish();
+
+    sup->start();
+    io_context.run();
+
+    CHECK(actor->cancelled == 2);
+    REQUIRE(actor->fired.size() == 2);
+    CHECK(actor->fired[0] == 1);
+    CHECK(actor->fired[1] == 2);
+    CHECK(sup->get_timers_queue().empty());
+    REQUIRE(sup->get_state() == r::state_t::SHUT_DOWN);
+}
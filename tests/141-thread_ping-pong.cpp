@@ -8,6 +8,7 @@
 #include "rotor.hpp"
 #include "rotor/thread.hpp"
 #include "access.h"
+#include <thread>
 
 namespace r = rotor;
 namespace rth = rotor::thread;
@@ -116,6 +117,51 @@ struct ponger_t : public r::actor_base_t {
     }
 };
 
+struct remote_pinger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&remote_pinger_t::on_pong); });
+        plugin.with_casted<r::plugin::link_client_plugin_t>(
+            [&](auto &p) { p.link(ponger_addr, true, [](auto &ec) { CHECK(!ec); }); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        send<ping_t>(ponger_addr);
+    }
+
+    void on_pong(rotor::message_t<pong_t> &) noexcept {
+        if (++pong_received < count) {
+            send<ping_t>(ponger_addr);
+        } else {
+            supervisor->shutdown();
+        }
+    }
+
+    rotor::address_ptr_t ponger_addr;
+    std::uint32_t count = 0;
+    std::uint32_t pong_received = 0;
+};
+
+struct remote_ponger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&remote_ponger_t::on_ping); });
+    }
+
+    void on_ping(rotor::message_t<ping_t> &) noexcept {
+        ++ping_received;
+        send<pong_t>(pinger_addr);
+    }
+
+    rotor::address_ptr_t pinger_addr;
+    std::uint32_t ping_received = 0;
+};
+
 struct bad_actor_t : public r::actor_base_t {
     using r::actor_base_t::actor_base_t;
 
@@ -191,3 +237,56 @@ TEST_CASE("supervisors hierarchy", "[supervisor][thread]") {
     CHECK(((r::actor_base_t *)act.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
     CHECK(((r::actor_base_t *)sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
 }
+
+TEST_CASE("ping/pong between threads, idle strategies", "[supervisor][thread]") {
+    using strategy_t = rth::idle_strategy_t;
+    for (auto strategy : {strategy_t::busy_spin, strategy_t::pause_spin, strategy_t::backoff, strategy_t::park}) {
+        auto ctx1 = r::intrusive_ptr_t<rth::system_context_thread_t>(new rth::system_context_thread_t(strategy));
+        auto ctx2 = r::intrusive_ptr_t<rth::system_context_thread_t>(new rth::system_context_thread_t(strategy));
+        CHECK(ctx1->get_idle_strategy() == strategy);
+        auto timeout = r::pt::milliseconds{100};
+        auto poll = r::pt::microseconds{100};
+        auto sup1 = ctx1->create_supervisor<rth::supervisor_thread_t>().timeout(timeout).poll_duration(poll).finish();
+        auto sup2 = ctx2->create_supervisor<rth::supervisor_thread_t>().timeout(timeout).poll_duration(poll).finish();
+
+        auto pinger = sup1->create_actor<remote_pinger_t>().timeout(timeout).finish();
+        auto ponger = sup2->create_actor<remote_ponger_t>().timeout(timeout).finish();
+        pinger->ponger_addr = ponger->get_address();
+        pinger->count = 1000;
+        ponger->pinger_addr = pinger->get_address();
+
+        std::thread thread([&]() { ctx2->run(); });
+        sup1->start();
+        ctx1->run();
+        sup2->shutdown();
+        thread.join();
+
+        CHECK(pinger->pong_received == 1000);
+        CHECK(ponger->ping_received == 1000);
+        CHECK(static_cast<r::actor_base_t *>(sup1.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+        CHECK(static_cast<r::actor_base_t *>(sup2.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+    }
+}
+
+TEST_CASE("adaptive spin budget", "[thread]") {
+    using namespace std::chrono_literals;
+    auto budget = rth::spin_budget_t(100us, true);
+    CHECK(budget.value == 100us);
+
+    // rare messages: do not poll at all
+    for (int i = 0; i < 50; ++i) {
+        budget.update(10ms);
+    }
+    CHECK(budget.value == 0us);
+
+    // frequent messages: poll a bit longer than the usual gap
+    for (int i = 0; i < 100; ++i) {
+        budget.update(10us);
+    }
+    CHECK(budget.value > 10us);
+    CHECK(budget.value < 30us);
+
+    auto fixed = rth::spin_budget_t(100us, false);
+    fixed.update(10ms);
+    CHECK(fixed.value == 100us);
+}
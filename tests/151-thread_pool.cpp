@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "rotor.hpp"
+#include "rotor/thread_pool.hpp"
+#include "access.h"
+#include <atomic>
+#include <vector>
+
+namespace r = rotor;
+namespace rtp = rotor::thread_pool;
+namespace rt = r::test;
+
+struct ping_t {};
+struct pong_t {};
+
+/* checks, that actors of the same supervisor are never executed concurrently */
+struct exclusive_sup_t : public rtp::supervisor_thread_pool_t {
+    using rtp::supervisor_thread_pool_t::supervisor_thread_pool_t;
+
+    struct guard_t {
+        guard_t(exclusive_sup_t &sup_) : sup{sup_} {
+            if (sup.executing.exchange(true)) {
+                ++sup.violations;
+            }
+        }
+        ~guard_t() { sup.executing.store(false); }
+        exclusive_sup_t &sup;
+    };
+
+    std::atomic_bool executing{false};
+    std::atomic_int violations{0};
+};
+
+struct pinger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&pinger_t::on_pong); });
+        // ponger is on other worker: start pinging only when it is operational
+        plugin.with_casted<r::plugin::link_client_plugin_t>(
+            [&](auto &p) { p.link(ponger_addr, true, [](auto &ec) { CHECK(!ec); }); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        send<ping_t>(ponger_addr);
+    }
+
+    void on_pong(r::message_t<pong_t> &) noexcept {
+        exclusive_sup_t::guard_t guard(static_cast<exclusive_sup_t &>(*supervisor));
+        if (++pongs < count) {
+            send<ping_t>(ponger_addr);
+        } else {
+            finished->fetch_add(1);
+            if (finished->load() == pairs) {
+                root->shutdown();
+            }
+        }
+    }
+
+    r::address_ptr_t ponger_addr;
+    r::supervisor_t *root = nullptr;
+    std::atomic_int *finished = nullptr;
+    int pairs = 1;
+    int count = 0;
+    int pongs = 0;
+};
+
+struct ponger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&ponger_t::on_ping); });
+    }
+
+    void on_ping(r::message_t<ping_t> &) noexcept {
+        exclusive_sup_t::guard_t guard(static_cast<exclusive_sup_t &>(*supervisor));
+        ++pings;
+        send<pong_t>(pinger_addr);
+    }
+
+    r::address_ptr_t pinger_addr;
+    int pings = 0;
+};
+
+struct timed_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        start_timer(r::pt::milliseconds(1), *this, &timed_actor_t::on_timer);
+        cancelled_id = start_timer(r::pt::minutes(1), *this, &timed_actor_t::on_timer);
+    }
+
+    void on_timer(r::request_id_t id, bool cancelled) noexcept {
+        if (cancelled) {
+            CHECK(id == cancelled_id);
+            ++cancellations;
+            return;
+        }
+        ++triggers;
+        cancel_timer(cancelled_id);
+        root->shutdown();
+    }
+
+    r::supervisor_t *root = nullptr;
+    r::request_id_t cancelled_id = 0;
+    int triggers = 0;
+    int cancellations = 0;
+};
+
+TEST_CASE("ping/pong across supervisors", "[supervisor][thread_pool]") {
+    auto ctx = r::intrusive_ptr_t<rtp::system_context_thread_pool_t>(new rtp::system_context_thread_pool_t(4));
+    CHECK(ctx->get_workers_count() == 4);
+
+    auto timeout = r::pt::milliseconds{100};
+    auto root = ctx->create_supervisor<exclusive_sup_t>().timeout(timeout).finish();
+
+    static constexpr int pairs = 8;
+    std::atomic_int finished{0};
+    std::vector<r::intrusive_ptr_t<exclusive_sup_t>> sups;
+    std::vector<r::intrusive_ptr_t<pinger_t>> pingers;
+    std::vector<r::intrusive_ptr_t<ponger_t>> pongers;
+    for (int i = 0; i < pairs; ++i) {
+        auto sup_ping = root->create_actor<exclusive_sup_t>().timeout(timeout).finish();
+        auto sup_pong = root->create_actor<exclusive_sup_t>().timeout(timeout).finish();
+        auto pinger = sup_ping->create_actor<pinger_t>().timeout(timeout).finish();
+        auto ponger = sup_pong->create_actor<ponger_t>().timeout(timeout).finish();
+        pinger->ponger_addr = ponger->get_address();
+        pinger->root = root.get();
+        pinger->finished = &finished;
+        pinger->pairs = pairs;
+        pinger->count = 1000;
+        ponger->pinger_addr = pinger->get_address();
+        CHECK(!sup_ping->get_address()->same_locality(*sup_pong->get_address()));
+        sups.emplace_back(sup_ping);
+        sups.emplace_back(sup_pong);
+        pingers.emplace_back(pinger);
+        pongers.emplace_back(ponger);
+    }
+
+    root->start();
+    ctx->run();
+
+    CHECK(finished == pairs);
+    for (auto &pinger : pingers) {
+        CHECK(pinger->pongs == 1000);
+    }
+    for (auto &ponger : pongers) {
+        CHECK(ponger->pings == 1000);
+    }
+    for (auto &sup : sups) {
+        CHECK(sup->violations == 0);
+        CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+    }
+    CHECK(static_cast<r::actor_base_t *>(root.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("timers", "[supervisor][thread_pool]") {
+    auto ctx = r::intrusive_ptr_t<rtp::system_context_thread_pool_t>(new rtp::system_context_thread_pool_t(2));
+    auto timeout = r::pt::milliseconds{100};
+    auto root = ctx->create_supervisor<rtp::supervisor_thread_pool_t>().timeout(timeout).finish();
+    auto sup = root->create_actor<rtp::supervisor_thread_pool_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<timed_actor_t>().timeout(timeout).finish();
+    act->root = root.get();
+
+    root->start();
+    ctx->run();
+
+    CHECK(act->triggers == 1);
+    CHECK(act->cancellations == 1);
+    CHECK(static_cast<r::actor_base_t *>(root.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
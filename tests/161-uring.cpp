@@ -0,0 +1,262 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "rotor.hpp"
+#include "rotor/uring.hpp"
+#include "access.h"
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace r = rotor;
+namespace ru = rotor::uring;
+namespace rt = r::test;
+
+using completions_t = std::vector<ru::payload::io_completion_t>;
+
+struct ping_t {};
+
+struct io_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&io_actor_t::on_completion);
+            p.subscribe_actor(&io_actor_t::on_ping);
+        });
+    }
+
+    ru::supervisor_uring_t &get_sup() noexcept { return static_cast<ru::supervisor_uring_t &>(*supervisor); }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        if (starter) {
+            starter(*this);
+        }
+    }
+
+    void on_ping(r::message_t<ping_t> &) noexcept {
+        ++pings;
+        supervisor->shutdown();
+    }
+
+    void on_completion(ru::message::io_completion_t &message) noexcept {
+        completions.emplace_back(message.payload);
+        if (on_io) {
+            on_io(*this, message.payload);
+        }
+    }
+
+    std::function<void(io_actor_t &)> starter;
+    std::function<void(io_actor_t &, const ru::payload::io_completion_t &)> on_io;
+    completions_t completions;
+    int pings = 0;
+};
+
+struct timed_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        start_timer(r::pt::milliseconds(1), *this, &timed_actor_t::on_timer);
+        cancelled_id = start_timer(r::pt::minutes(1), *this, &timed_actor_t::on_timer);
+    }
+
+    void on_timer(r::request_id_t id, bool cancelled) noexcept {
+        if (cancelled) {
+            CHECK(id == cancelled_id);
+            ++cancellations;
+            return;
+        }
+        ++triggers;
+        cancel_timer(cancelled_id);
+        supervisor->shutdown();
+    }
+
+    r::request_id_t cancelled_id = 0;
+    int triggers = 0;
+    int cancellations = 0;
+};
+
+static auto make_context() { return r::intrusive_ptr_t<ru::system_context_uring_t>(new ru::system_context_uring_t()); }
+
+TEST_CASE("ping", "[supervisor][uring]") {
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<ru::supervisor_uring_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<io_actor_t>().timeout(timeout).finish();
+    act->starter = [](io_actor_t &self) { self.send<ping_t>(self.get_address()); };
+
+    sup->start();
+    ctx->run();
+
+    CHECK(act->pings == 1);
+    CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("timers", "[supervisor][uring]") {
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<ru::supervisor_uring_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<timed_actor_t>().timeout(timeout).finish();
+
+    sup->start();
+    ctx->run();
+
+    CHECK(act->triggers == 1);
+    CHECK(act->cancellations == 1);
+    CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("wake-up from other thread", "[supervisor][uring]") {
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<ru::supervisor_uring_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<io_actor_t>().timeout(timeout).finish();
+
+    sup->start();
+    std::thread thread([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto addr = act->get_address();
+        sup->enqueue(r::make_message<ping_t>(addr));
+    });
+    ctx->run();
+    thread.join();
+
+    CHECK(act->pings == 1);
+    CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("pipe write & read", "[supervisor][uring]") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<ru::supervisor_uring_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<io_actor_t>().timeout(timeout).finish();
+
+    std::string out = "hello";
+    char in[16] = {0};
+    ru::io_id_t read_id = 0, write_id = 0;
+    act->starter = [&](io_actor_t &self) {
+        auto &addr = self.get_address();
+        read_id = self.get_sup().read(addr, fds[0], in, sizeof(in));
+        write_id = self.get_sup().write(addr, fds[1], out.data(), static_cast<std::uint32_t>(out.size()));
+    };
+    act->on_io = [&](io_actor_t &self, auto &) {
+        if (self.completions.size() == 2) {
+            self.get_supervisor().shutdown();
+        }
+    };
+
+    sup->start();
+    ctx->run();
+
+    REQUIRE(act->completions.size() == 2);
+    for (auto &c : act->completions) {
+        CHECK(!c.ec());
+        CHECK(c.result == 5);
+        if (c.operation == ru::io_operation_t::read) {
+            CHECK(c.id == read_id);
+            CHECK(c.fd == fds[0]);
+        } else {
+            CHECK(c.operation == ru::io_operation_t::write);
+            CHECK(c.id == write_id);
+            CHECK(c.fd == fds[1]);
+        }
+    }
+    CHECK(std::string(in) == out);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_CASE("cancel read", "[supervisor][uring]") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<ru::supervisor_uring_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<io_actor_t>().timeout(timeout).finish();
+
+    char in[16];
+    act->starter = [&](io_actor_t &self) {
+        auto id = self.get_sup().read(self.get_address(), fds[0], in, sizeof(in));
+        self.get_sup().cancel_io(id);
+    };
+    act->on_io = [&](io_actor_t &self, auto &) { self.get_supervisor().shutdown(); };
+
+    sup->start();
+    ctx->run();
+
+    REQUIRE(act->completions.size() == 1);
+    CHECK(act->completions[0].ec() == std::errc::operation_canceled);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_CASE("accept & connect", "[supervisor][uring]") {
+    auto listener = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(listener >= 0);
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+    REQUIRE(listen(listener, 1) == 0);
+    socklen_t addr_len = sizeof(addr);
+    REQUIRE(getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &addr_len) == 0);
+    auto client = socket(AF_INET, SOCK_STREAM, 0);
+    REQUIRE(client >= 0);
+
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<ru::supervisor_uring_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<io_actor_t>().timeout(timeout).finish();
+
+    int accepted = -1;
+    char in[16] = {0};
+    std::string out = "ping";
+    act->starter = [&](io_actor_t &self) {
+        auto &dest = self.get_address();
+        self.get_sup().accept(dest, listener);
+        self.get_sup().connect(dest, client, reinterpret_cast<sockaddr *>(&addr), addr_len);
+    };
+    act->on_io = [&](io_actor_t &self, auto &c) {
+        auto &dest = self.get_address();
+        using op_t = ru::io_operation_t;
+        CHECK(!c.ec());
+        if (c.operation == op_t::accept) {
+            accepted = c.result;
+            self.get_sup().read(dest, accepted, in, sizeof(in));
+        } else if (c.operation == op_t::connect) {
+            self.get_sup().write(dest, client, out.data(), static_cast<std::uint32_t>(out.size()));
+        } else if (c.operation == op_t::read) {
+            self.get_supervisor().shutdown();
+        }
+    };
+
+    sup->start();
+    ctx->run();
+
+    CHECK(act->completions.size() == 4);
+    CHECK(accepted >= 0);
+    CHECK(std::string(in) == out);
+    close(accepted);
+    close(client);
+    close(listener);
+}
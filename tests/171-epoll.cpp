@@ -0,0 +1,247 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include <catch2/catch_test_macros.hpp>
+#include "rotor.hpp"
+#include "rotor/epoll.hpp"
+#include "access.h"
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace r = rotor;
+namespace re = rotor::epoll;
+namespace rt = r::test;
+
+struct ping_t {};
+struct pong_t {};
+
+struct fd_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) {
+            p.subscribe_actor(&fd_actor_t::on_ready);
+            p.subscribe_actor(&fd_actor_t::on_ping);
+        });
+    }
+
+    re::supervisor_epoll_t &get_sup() noexcept { return static_cast<re::supervisor_epoll_t &>(*supervisor); }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        if (starter) {
+            starter(*this);
+        }
+    }
+
+    void on_ping(r::message_t<ping_t> &) noexcept {
+        ++pings;
+        supervisor->shutdown();
+    }
+
+    void on_ready(re::message::fd_ready_t &message) noexcept {
+        readiness.emplace_back(message.payload);
+        if (on_fd) {
+            on_fd(*this, message.payload);
+        }
+    }
+
+    std::function<void(fd_actor_t &)> starter;
+    std::function<void(fd_actor_t &, const re::payload::fd_ready_t &)> on_fd;
+    std::vector<re::payload::fd_ready_t> readiness;
+    int pings = 0;
+};
+
+struct timed_actor_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        start_timer(r::pt::milliseconds(1), *this, &timed_actor_t::on_timer);
+        cancelled_id = start_timer(r::pt::minutes(1), *this, &timed_actor_t::on_timer);
+    }
+
+    void on_timer(r::request_id_t id, bool cancelled) noexcept {
+        if (cancelled) {
+            CHECK(id == cancelled_id);
+            ++cancellations;
+            return;
+        }
+        ++triggers;
+        cancel_timer(cancelled_id);
+        supervisor->shutdown();
+    }
+
+    r::request_id_t cancelled_id = 0;
+    int triggers = 0;
+    int cancellations = 0;
+};
+
+struct ponger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&ponger_t::on_ping); });
+    }
+
+    void on_ping(r::message_t<ping_t> &) noexcept {
+        ++pings;
+        send<pong_t>(pinger_addr);
+    }
+
+    r::address_ptr_t pinger_addr;
+    int pings = 0;
+};
+
+struct pinger_t : public r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>([](auto &p) { p.subscribe_actor(&pinger_t::on_pong); });
+        plugin.with_casted<r::plugin::link_client_plugin_t>([&](auto &p) { p.link(ponger_addr, true); });
+    }
+
+    void on_start() noexcept override {
+        r::actor_base_t::on_start();
+        send<ping_t>(ponger_addr);
+    }
+
+    void on_pong(r::message_t<pong_t> &) noexcept {
+        if (++pongs == total) {
+            do_shutdown();
+        } else {
+            send<ping_t>(ponger_addr);
+        }
+    }
+
+    r::address_ptr_t ponger_addr;
+    int total = 0;
+    int pongs = 0;
+};
+
+static auto make_context() { return re::system_context_ptr_t(new re::system_context_epoll_t()); }
+
+TEST_CASE("ping", "[supervisor][epoll]") {
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<re::supervisor_epoll_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<fd_actor_t>().timeout(timeout).finish();
+    act->starter = [](fd_actor_t &self) { self.send<ping_t>(self.get_address()); };
+
+    sup->start();
+    ctx->run();
+
+    CHECK(act->pings == 1);
+    CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("timers", "[supervisor][epoll]") {
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<re::supervisor_epoll_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<timed_actor_t>().timeout(timeout).finish();
+
+    sup->start();
+    ctx->run();
+
+    CHECK(act->triggers == 1);
+    CHECK(act->cancellations == 1);
+    CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("wake-up from other thread", "[supervisor][epoll]") {
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<re::supervisor_epoll_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<fd_actor_t>().timeout(timeout).finish();
+
+    sup->start();
+    std::thread thread([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto addr = act->get_address();
+        sup->enqueue(r::make_message<ping_t>(addr));
+    });
+    ctx->run();
+    thread.join();
+
+    CHECK(act->pings == 1);
+    CHECK(static_cast<r::actor_base_t *>(sup.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("ping/pong between threads", "[supervisor][epoll]") {
+    auto ctx_ping = make_context();
+    auto ctx_pong = make_context();
+    REQUIRE(!ctx_ping->get_error());
+    REQUIRE(!ctx_pong->get_error());
+    auto timeout = r::pt::milliseconds{500};
+    auto sup_ping = ctx_ping->create_supervisor<re::supervisor_epoll_t>().timeout(timeout).finish();
+    auto sup_pong = ctx_pong->create_supervisor<re::supervisor_epoll_t>().timeout(timeout).finish();
+    auto ponger = sup_pong->create_actor<ponger_t>().timeout(timeout).finish();
+    auto pinger = sup_ping->create_actor<pinger_t>().timeout(timeout).autoshutdown_supervisor().finish();
+    pinger->ponger_addr = ponger->get_address();
+    pinger->total = 1000;
+    ponger->pinger_addr = pinger->get_address();
+
+    sup_ping->start();
+    sup_pong->start();
+    std::thread pong_thread([&]() { ctx_pong->run(); });
+    ctx_ping->run();
+    sup_pong->shutdown();
+    pong_thread.join();
+
+    CHECK(pinger->pongs == 1000);
+    CHECK(ponger->pings == 1000);
+    CHECK(static_cast<r::actor_base_t *>(sup_ping.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+    CHECK(static_cast<r::actor_base_t *>(sup_pong.get())->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+}
+
+TEST_CASE("pipe readiness", "[supervisor][epoll]") {
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    auto ctx = make_context();
+    REQUIRE(!ctx->get_error());
+    auto timeout = r::pt::milliseconds{100};
+    auto sup = ctx->create_supervisor<re::supervisor_epoll_t>().timeout(timeout).finish();
+    auto act = sup->create_actor<fd_actor_t>().timeout(timeout).finish();
+
+    std::string in;
+    act->starter = [&](fd_actor_t &self) {
+        auto ec = self.get_sup().watch_fd(self.get_address(), fds[0], EPOLLIN);
+        CHECK(!ec);
+        CHECK(self.get_sup().watch_fd(self.get_address(), fds[0], EPOLLIN) == std::errc::file_exists);
+        CHECK(write(fds[1], "a", 1) == 1);
+    };
+    act->on_fd = [&](fd_actor_t &self, auto &ready) {
+        CHECK(ready.fd == fds[0]);
+        CHECK(ready.events & EPOLLIN);
+        char c;
+        CHECK(read(fds[0], &c, 1) == 1);
+        in += c;
+        if (in.size() == 1) {
+            CHECK(!self.get_sup().rearm_fd(fds[0]));
+            CHECK(write(fds[1], "b", 1) == 1);
+        } else {
+            self.get_sup().unwatch_fd(fds[0]);
+            CHECK(self.get_sup().rearm_fd(fds[0]) == std::errc::no_such_file_or_directory);
+            self.get_supervisor().shutdown();
+        }
+    };
+
+    sup->start();
+    ctx->run();
+
+    CHECK(act->readiness.size() == 2);
+    CHECK(in == "ab");
+    close(fds[0]);
+    close(fds[1]);
+}
@@ -0,0 +1,194 @@
+//
+// Copyright (c) 2019-2023 Ivan Baidakou (basiliscos) (the dot dmol at gmail dot com)
+//
+// Distributed under the MIT Software License
+//
+
+#include "rotor.hpp"
+#include "rotor/coro.hpp"
+#include "supervisor_test.h"
+#include "access.h"
+
+namespace r = rotor;
+namespace rc = rotor::coro;
+namespace rt = r::test;
+
+namespace payload {
+
+struct sample_res_t {
+    int value;
+};
+
+struct sample_req_t {
+    using response_t = sample_res_t;
+    int value;
+};
+
+} // namespace payload
+
+using traits_t = r::request_traits_t<payload::sample_req_t>;
+using req_ptr_t = r::intrusive_ptr_t<traits_t::request::message_t>;
+
+struct server_actor_t : r::actor_base_t {
+    using r::actor_base_t::actor_base_t;
+
+    void configure(r::plugin::plugin_base_t &plugin) noexcept override {
+        r::actor_base_t::configure(plugin);
+        plugin.with_casted<r::plugin::starter_plugin_t>(
+            [](auto &p) { p.subscribe_actor(&server_actor_t::on_request); });
+    }
+
+    void shutdown_start() noexcept override {
+        req.reset();
+        r::actor_base_t::shutdown_start();
+    }
+
+    void on_request(traits_t::request::message_t &msg) noexcept {
+        ++requests;
+        if (silent) {
+            req.reset(&msg);
+        } else {
+            reply_to(msg, msg.payload.request_payload.value + 1);
+        }
+    }
+
+    bool silent = false;
+    int requests = 0;
+    req_ptr_t req;
+};
+
+struct guard_t {
+    bool &destroyed;
+    ~guard_t() { destroyed = true; }
+};
+
+struct client_actor_t : rc::actor_t {
+    using rc::actor_t::actor_t;
+
+    rc::task_t flow(int value) noexcept {
+        guard_t guard{destroyed};
+        for (int i = 0; i < 3; ++i) {
+            auto res = co_await request<payload::sample_req_t>(server, value).send(rt::default_timeout);
+            if (res->payload.ee) {
+                ee = res->payload.ee;
+                co_return;
+            }
+            value = res->payload.res.value;
+            ++steps;
+        }
+        result = value;
+    }
+
+    r::address_ptr_t server;
+    r::extended_error_ptr_t ee;
+    int steps = 0;
+    int result = 0;
+    bool destroyed = false;
+};
+
+TEST_CASE("coroutine awaits responses", "[coro]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto server = sup->create_actor<server_actor_t>().timeout(rt::default_timeout).finish();
+    auto client = sup->create_actor<client_actor_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+    REQUIRE(client->access<rt::to::state>() == r::state_t::OPERATIONAL);
+
+    client->server = server->get_address();
+    client->flow(5);
+    CHECK(client->steps == 0);
+    CHECK(client->result == 0);
+
+    sup->do_process();
+    CHECK(server->requests == 3);
+    CHECK(client->steps == 3);
+    CHECK(client->result == 8);
+    CHECK(!client->ee);
+    CHECK(client->destroyed);
+    CHECK(sup->get_requests().size() == 0);
+    CHECK(sup->active_timers.size() == 0);
+
+    auto &pool = sup->get_frame_pool();
+    auto misses = pool.misses();
+    CHECK(misses == 1);
+
+    client->destroyed = false;
+    client->flow(10);
+    sup->do_process();
+    CHECK(client->result == 13);
+    CHECK(client->destroyed);
+    CHECK(pool.misses() == misses);
+    CHECK(pool.hits() == 1);
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(sup->get_leader_queue().size() == 0);
+    CHECK(rt::empty(sup->get_subscription()));
+}
+
+TEST_CASE("coroutine is resumed with timeout error", "[coro]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto server = sup->create_actor<server_actor_t>().timeout(rt::default_timeout).finish();
+    auto client = sup->create_actor<client_actor_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+
+    server->silent = true;
+    client->server = server->get_address();
+    client->flow(5);
+    sup->do_process();
+    CHECK(server->requests == 1);
+    REQUIRE(sup->active_timers.size() == 1);
+    CHECK(!client->destroyed);
+
+    auto timer_it = *sup->active_timers.begin();
+    sup->do_invoke_timer(timer_it->request_id);
+    sup->do_process();
+    REQUIRE(client->ee);
+    CHECK(client->ee->ec == r::error_code_t::request_timeout);
+    CHECK(client->steps == 0);
+    CHECK(client->destroyed);
+    CHECK(sup->get_requests().size() == 0);
+
+    // late reply is dropped
+    server->reply_to(*server->req, 1);
+    sup->do_process();
+    CHECK(client->steps == 0);
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(rt::empty(sup->get_subscription()));
+}
+
+TEST_CASE("awaiting coroutine is destroyed on actor shutdown", "[coro]") {
+    r::system_context_t system_context;
+
+    auto sup = system_context.create_supervisor<rt::supervisor_test_t>().timeout(rt::default_timeout).finish();
+    auto server = sup->create_actor<server_actor_t>().timeout(rt::default_timeout).finish();
+    auto client = sup->create_actor<client_actor_t>().timeout(rt::default_timeout).finish();
+    sup->do_process();
+
+    server->silent = true;
+    client->server = server->get_address();
+    client->flow(5);
+    sup->do_process();
+    CHECK(!client->destroyed);
+
+    client->do_shutdown();
+    sup->do_process();
+    CHECK(client->access<rt::to::state>() == r::state_t::SHUT_DOWN);
+    CHECK(client->destroyed);
+    CHECK(client->steps == 0);
+    CHECK(!client->ee);
+    CHECK(sup->get_requests().size() == 0);
+    CHECK(sup->active_timers.size() == 0);
+
+    sup->do_shutdown();
+    sup->do_process();
+    CHECK(sup->get_state() == r::state_t::SHUT_DOWN);
+    CHECK(rt::empty(sup->get_subscription()));
+}
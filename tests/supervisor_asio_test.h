@@ -15,7 +15,7 @@ namespace test {
 struct supervisor_asio_test_t : public rotor::asio::supervisor_asio_t {
     using rotor::asio::supervisor_asio_t::supervisor_asio_t;
 
-    timers_map_t &get_timers_map() noexcept { return timers_map; }
+    timers_queue_t &get_timers_queue() noexcept { return timers_queue; }
     state_t &get_state() noexcept { return state; }
     auto &get_leader_queue() { return access<to::locality_leader>()->access<to::queue>(); }
 
@@ -32,7 +32,8 @@ void supervisor_test_t::do_start_timer(const pt::time_duration &, timer_handler_
     active_timers.emplace_back(&handler);
 }
 
-void supervisor_test_t::do_cancel_timer(request_id_t timer_id) noexcept {
+void supervisor_test_t::do_cancel_timer(timer_handler_base_t &handler) noexcept {
+    auto timer_id = handler.request_id;
     printf("cancelling timer %zu (%p)\n", timer_id, (void *)this);
     auto it = active_timers.begin();
     while (it != active_timers.end()) {
@@ -105,8 +106,7 @@ system_test_context_t::~system_test_context_t() {
         auto &queue = sup->access<to::queue>();
         auto &inbound = sup->access<to::inbound_queue>();
         while (!queue.empty()) {
-            inbound.push(queue.front().detach());
-            queue.pop_front();
+            inbound.push(queue.pop().detach());
         }
     }
 }
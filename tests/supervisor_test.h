@@ -38,7 +38,7 @@ struct supervisor_test_t : public supervisor_t {
 
     void configure(plugin::plugin_base_t &plugin) noexcept override;
     virtual void do_start_timer(const pt::time_duration &interval, timer_handler_base_t &handler) noexcept override;
-    virtual void do_cancel_timer(request_id_t timer_id) noexcept override;
+    virtual void do_cancel_timer(timer_handler_base_t &handler) noexcept override;
     void do_invoke_timer(request_id_t timer_id) noexcept;
     request_id_t get_timer(std::size_t index) noexcept;
     virtual void start() noexcept override {}
@@ -48,7 +48,7 @@ struct supervisor_test_t : public supervisor_t {
     void intercept(message_ptr_t &message, const void *tag, const continuation_t &continuation) noexcept override;
 
     state_t &get_state() noexcept { return state; }
-    messages_queue_t &get_leader_queue() { return get_leader().queue; }
+    message_lanes_t &get_leader_queue() { return get_leader().queue; }
     supervisor_test_t &get_leader();
     subscription_container_t &get_points() noexcept;
     subscription_t &get_subscription() noexcept { return subscription_map; }